@@ -0,0 +1,47 @@
+#ifndef A_STAR_H
+#define A_STAR_H
+
+#include <limits>
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+
+// A* на плотных индексах: Дейкстра, у которой ключ в куче —
+// g(v) + h(v), где h — нижняя оценка расстояния от v до финиша.
+// Эвристика должна быть согласованной (h(u) <= w(u, v) + h(v)), тогда
+// каждая вершина извлекается один раз, а метки ws — точные расстояния
+// от start для извлечённых вершин, как у dijkstraSearch.
+// h — вызываемый объект double(int v).
+template<typename Heap = DefaultDijkstraHeap, typename G, typename H>
+void aStarSearch(const G& graph, int start, int finish, H&& heuristic, QueryWorkspace& ws,
+                 Heap& heap = localQueue<Heap>())
+{
+    ws.reset(graph.vertexCount());
+    heap.clear();
+
+    ws.setLabel(start, 0.0, -1);
+    heap.push(start, heuristic(start));
+
+    while (!heap.empty())
+    {
+        auto [key, cur] = heap.pop();
+
+        // Устаревшая запись: ключ считался от прежней, большей метки
+        double curDist = ws.distance(cur);
+        if (key > curDist + heuristic(cur))
+            continue;
+        if (cur == finish)
+            break;
+
+        graph.forEachOut(cur, [&](int neigh, double weight){
+            double alt = curDist + weight;
+            if (alt < ws.distance(neigh))
+            {
+                ws.setLabel(neigh, alt, cur);
+                heap.push(neigh, alt + heuristic(neigh));
+            }
+        });
+    }
+}
+
+#endif // A_STAR_H
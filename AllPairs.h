@@ -0,0 +1,284 @@
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <limits>
+#include <fstream>
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_map>
+#include "Path.h"
+#include "DynamicArray.h"
+#include "Dijkstra.h"
+#include "Parallel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Кратчайшие пути между всеми парами для небольших плотных графов
+// (до нескольких тысяч вершин): блочный Флойд — Уоршелл.
+// Матрица расстояний хранится одним массивом, строки дополнены до
+// кратного BLOCK размера (заполнитель — бесконечность), так что каждый
+// блок BLOCK x BLOCK — целые отрезки строк, которые помещаются в кэш.
+// На шаге kb сначала считается диагональный блок (kb, kb), затем
+// параллельно блоки строки и столбца kb, затем параллельно все остальные.
+// Внутреннее ядро min-plus векторизовано AVX2 (сборка с -mavx2, см.
+// LAB4_AVX2 в CMakeLists.txt), иначе работает скалярный вариант.
+// next[i][j] — следующая после i вершина кратчайшего пути i -> j.
+// Отрицательные рёбра допустимы, отрицательный цикл — исключение.
+
+template<typename T>
+class AllPairsShortestPaths
+{
+public:
+    static constexpr int BLOCK = 64;
+
+private:
+    std::vector<T> names;
+    std::unordered_map<T, int> indices;
+    int vertexCount = 0;
+    int stride = 0;                 // длина дополненной строки
+    std::vector<double> dist;       // stride x stride
+    std::vector<int> next;          // stride x stride, -1 — пути нет
+
+    // C[i][j] = min(C[i][j], A[i][k] + B[k][j]) для блоков
+    // C = (ib, jb), A = (ib, kb), B = (kb, jb); k — внешний цикл,
+    // поэтому блоки могут совпадать (фазы 1 и 2)
+    void updateBlock(int ib, int jb, int kb)
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const std::size_t s = stride;
+        for (int k = kb * BLOCK; k < (kb + 1) * BLOCK; ++k)
+        {
+            const double* bk = &dist[k * s + jb * BLOCK];
+            for (int i = ib * BLOCK; i < (ib + 1) * BLOCK; ++i)
+            {
+                const double aik = dist[i * s + k];
+                if (aik == INF)
+                    continue;
+                relaxRow(&dist[i * s + jb * BLOCK], &next[i * s + jb * BLOCK],
+                         bk, aik, next[i * s + k]);
+            }
+        }
+    }
+
+    // Ядро: ci[j] = min(ci[j], aik + bk[j]) на отрезке из BLOCK элементов
+    static void relaxRow(double* ci, int* ni, const double* bk, double aik, int nik)
+    {
+#if defined(__AVX2__)
+        const __m256d a = _mm256_set1_pd(aik);
+        for (int j = 0; j < BLOCK; j += 4)
+        {
+            __m256d c = _mm256_loadu_pd(ci + j);
+            __m256d alt = _mm256_add_pd(a, _mm256_loadu_pd(bk + j));
+            __m256d less = _mm256_cmp_pd(alt, c, _CMP_LT_OQ);
+            int mask = _mm256_movemask_pd(less);
+            if (mask == 0)
+                continue;
+            // Улучшения редки: next правим только в изменившихся ячейках
+            _mm256_storeu_pd(ci + j, _mm256_blendv_pd(c, alt, less));
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (mask & (1 << lane))
+                    ni[j + lane] = nik;
+            }
+        }
+#else
+        for (int j = 0; j < BLOCK; ++j)
+        {
+            double alt = aik + bk[j];
+            if (alt < ci[j])
+            {
+                ci[j] = alt;
+                ni[j] = nik;
+            }
+        }
+#endif
+    }
+
+public:
+    AllPairsShortestPaths() = default;
+
+    // G — Graph<T> или CsrGraph<T> (vertexCount, vertexName, forEachOut)
+    template<typename G>
+    explicit AllPairsShortestPaths(const G& graph, int threadCount = defaultThreadCount())
+        : vertexCount(graph.vertexCount())
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const int n = vertexCount;
+        const int blocks = (n + BLOCK - 1) / BLOCK;
+        stride = blocks * BLOCK;
+        const std::size_t s = stride;
+
+        names.reserve(n);
+        indices.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            names.push_back(graph.vertexName(i));
+            indices.emplace(names.back(), i);
+        }
+
+        dist.assign(s * s, INF);
+        next.assign(s * s, -1);
+        for (int u = 0; u < n; ++u)
+        {
+            dist[u * s + u] = 0.0;
+            next[u * s + u] = u;
+            // Из параллельных рёбер берём самое лёгкое
+            graph.forEachOut(u, [&](int v, double w){
+                if (w < dist[u * s + v])
+                {
+                    dist[u * s + v] = w;
+                    next[u * s + v] = v;
+                }
+            });
+        }
+
+        // Один пул на весь прогон: на каждый kb приходится две
+        // параллельные фазы, лишние потоки на маленьком графе не нужны
+        const int tasks = std::max(2 * (blocks - 1), (blocks - 1) * (blocks - 1));
+        ThreadPool pool(std::min(threadCount, std::max(tasks, 1)));
+        for (int kb = 0; kb < blocks; ++kb)
+        {
+            // 1) диагональный блок
+            updateBlock(kb, kb, kb);
+
+            // 2) строка и столбец kb: блоки независимы друг от друга
+            if (blocks > 1)
+            {
+                parallelFor(pool, 2 * (blocks - 1), [&](int t){
+                    int other = t / 2;
+                    if (other >= kb)
+                        ++other;
+                    if (t % 2 == 0)
+                        updateBlock(kb, other, kb);
+                    else
+                        updateBlock(other, kb, kb);
+                });
+            }
+
+            // 3) остальные блоки
+            const int rest = blocks - 1;
+            if (rest > 0)
+            {
+                parallelFor(pool, rest * rest, [&](int t){
+                    int ib = t / rest;
+                    int jb = t % rest;
+                    if (ib >= kb)
+                        ++ib;
+                    if (jb >= kb)
+                        ++jb;
+                    updateBlock(ib, jb, kb);
+                });
+            }
+        }
+
+        for (int v = 0; v < n; ++v)
+        {
+            if (dist[v * s + v] < 0.0)
+                throw std::runtime_error("В графе есть цикл отрицательного веса.");
+        }
+    }
+
+    int size() const { return vertexCount; }
+
+    int indexOf(const T& name) const
+    {
+        auto it = indices.find(name);
+        return it == indices.end() ? -1 : it->second;
+    }
+
+    // Бесконечность — пути нет
+    double distance(int from, int to) const
+    {
+        return dist[static_cast<std::size_t>(from) * stride + to];
+    }
+
+    // Индексы вершин пути from -> to (пусто, если пути нет)
+    std::vector<int> route(int from, int to) const
+    {
+        std::vector<int> result;
+        const std::size_t s = stride;
+        if (next[from * s + to] < 0)
+            return result;
+        result.push_back(from);
+        for (int v = from; v != to; )
+        {
+            v = next[v * s + to];
+            result.push_back(v);
+        }
+        return result;
+    }
+
+    // Тот же результат, что у Graph<T>::dijkstraPath: расстояния от
+    // startName до всех вершин (-1 — недостижима) и сам путь
+    Path<T> path(const T& startName, const T& finishName) const
+    {
+        const int start = indexOf(startName);
+        const int finish = indexOf(finishName);
+        if (start < 0 || finish < 0)
+            return makeMissingPath<T>(vertexCount);
+
+        const double INF = std::numeric_limits<double>::infinity();
+        DynamicArray<int> distArr;
+        DynamicArray<T> pathArr;
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            double d = distance(start, v);
+            distArr.push_back(d == INF ? -1 : static_cast<int>(d));
+        }
+        for (int v : route(start, finish))
+            pathArr.push_back(names[v]);
+        return Path<T>(std::move(distArr), std::move(pathArr));
+    }
+
+    // Выгрузка в формате input.txt: первая строка — вершины через
+    // запятую, дальше "from,to,distance" для каждой достижимой пары
+    // (from != to). Загрузчик графа читает веса как int, поэтому
+    // пишутся только целые расстояния в пределах int; иначе —
+    // исключение до записи файла.
+    void save(const std::string& fileName) const
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        for (int from = 0; from < vertexCount; ++from)
+        {
+            for (int to = 0; to < vertexCount; ++to)
+            {
+                double d = distance(from, to);
+                if (from == to || d == INF)
+                    continue;
+                if (d != std::floor(d) || d < std::numeric_limits<int>::min()
+                    || d > std::numeric_limits<int>::max())
+                {
+                    throw std::runtime_error("Расстояние не целое или не помещается в int: "
+                                             "такой файл не прочитать загрузкой графа.");
+                }
+            }
+        }
+
+        std::ofstream out(fileName);
+        if (!out)
+            throw std::runtime_error("Не удалось открыть файл для записи: " + fileName);
+
+        for (int v = 0; v < vertexCount; ++v)
+            out << names[v] << (v + 1 < vertexCount ? "," : "");
+        out << "\n";
+        for (int from = 0; from < vertexCount; ++from)
+        {
+            for (int to = 0; to < vertexCount; ++to)
+            {
+                double d = distance(from, to);
+                if (from != to && d != INF)
+                    out << names[from] << "," << names[to] << "," << static_cast<int>(d) << "\n";
+            }
+        }
+        if (!out)
+            throw std::runtime_error("Ошибка записи файла: " + fileName);
+    }
+};
+
+#endif // ALL_PAIRS_H
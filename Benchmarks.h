@@ -0,0 +1,517 @@
+#ifndef LAB4_BENCHMARKS
+#define LAB4_BENCHMARKS
+
+#include "Graph.h"
+#include "ContractionHierarchy.h"
+#include "DeltaStepping.h"
+#include "AllPairs.h"
+#include "DynamicShortestPaths.h"
+#include "ParallelBfs.h"
+#include "MultiSourceBfs.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <iostream>
+
+// Замеры производительности. Запуск: lab_4 --bench
+
+// Случайный ориентированный граф: у каждой вершины degree исходящих
+// рёбер с целыми весами [1, maxWeight]
+inline Graph<int> MakeRandomGraph(int vertexCount, int degree, int maxWeight, unsigned seed = 42)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertexDist(0, vertexCount - 1);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    Graph<int> graph;
+    for (int i = 0; i < vertexCount; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        for (int k = 0; k < degree; ++k)
+            graph.addEdge(i, vertexDist(rng), weightDist(rng));
+    }
+    return graph;
+}
+
+// Время выполнения f() в миллисекундах
+template<typename F>
+double MeasureMs(F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+// -----------------------------------------------------------------
+//  Кучи в Дейкстре: число операций и пиковый размер на плотном графе
+template<typename Heap>
+void BenchmarkHeap(const char* label, const CsrGraph<int>& graph, int queries)
+{
+    Heap heap;
+    QueryWorkspace ws;
+    double ms = MeasureMs([&]{
+        for (int q = 0; q < queries; ++q)
+            dijkstraSearch(graph, q % graph.vertexCount(), -1, ws, heap);
+    });
+
+    std::cout << label
+              << ": " << ms / queries << " ms/query"
+              << ", pushes " << heap.stats.pushes / queries
+              << ", pops " << heap.stats.pops / queries
+              << ", decrease-key " << heap.stats.decreases / queries
+              << ", peak size " << heap.stats.peakSize << "\n";
+}
+
+inline void BenchmarkHeaps(int vertexCount = 2000, int degree = 500, int queries = 20)
+{
+    CsrGraph<int> graph = MakeRandomGraph(vertexCount, degree, 1000).freeze();
+    std::cout << "Heaps, V = " << vertexCount << ", E = " << graph.edgeCount() << "\n";
+
+    BenchmarkHeap<LazyHeap>("  lazy binary heap  ", graph, queries);
+    BenchmarkHeap<IndexedHeap<2>>("  indexed 2-ary heap", graph, queries);
+    BenchmarkHeap<IndexedHeap<4>>("  indexed 4-ary heap", graph, queries);
+    BenchmarkHeap<IndexedHeap<8>>("  indexed 8-ary heap", graph, queries);
+}
+
+// Корзины Дайала против куч на разреженном графе с весами как в GUI (1..100)
+inline void BenchmarkSmallWeights(int vertexCount = 200000, int degree = 4, int queries = 20)
+{
+    CsrGraph<int> graph = MakeRandomGraph(vertexCount, degree, 100).freeze();
+    std::cout << "Small integer weights, V = " << vertexCount << ", E = " << graph.edgeCount() << "\n";
+
+    BenchmarkHeap<LazyHeap>("  lazy binary heap  ", graph, queries);
+    BenchmarkHeap<IndexedHeap<4>>("  indexed 4-ary heap", graph, queries);
+    BenchmarkHeap<BucketQueue>("  bucket queue      ", graph, queries);
+}
+
+// «Дорожная» решётка side x side: рёбра в обе стороны к соседям по
+// строке и столбцу, веса [1, maxWeight]
+inline Graph<int> MakeGridGraph(int side, int maxWeight, unsigned seed = 42)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    Graph<int> graph;
+    for (int i = 0; i < side * side; ++i)
+        graph.addVertex(i);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+            {
+                int w = weightDist(rng);
+                graph.addEdge(v, v + 1, w);
+                graph.addEdge(v + 1, v, w);
+            }
+            if (r + 1 < side)
+            {
+                int w = weightDist(rng);
+                graph.addEdge(v, v + side, w);
+                graph.addEdge(v + side, v, w);
+            }
+        }
+    }
+    return graph;
+}
+
+// -----------------------------------------------------------------
+//  Иерархия сжатий против Дейкстры: предобработка и задержка запроса
+inline void BenchmarkContractionHierarchy(int side = 150, int queries = 200)
+{
+    CsrGraph<int> graph = MakeGridGraph(side, 100).freeze();
+    std::cout << "Contraction hierarchy, V = " << graph.vertexCount()
+              << ", E = " << graph.edgeCount() << "\n";
+
+    ContractionHierarchy<int> ch;
+    double buildMs = MeasureMs([&]{ ch = ContractionHierarchy<int>(graph); });
+    std::cout << "  preprocessing: " << buildMs << " ms, shortcuts " << ch.shortcutCount() << "\n";
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> vertexDist(0, graph.vertexCount() - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& p : pairs)
+        p = {vertexDist(rng), vertexDist(rng)};
+
+    long long checksum = 0;
+    double dijkstraMs = MeasureMs([&]{
+        for (auto [s, f] : pairs)
+            checksum += graph.dijkstraPath(s, f).GetDistances()[f];
+    });
+    double chMs = MeasureMs([&]{
+        for (auto [s, f] : pairs)
+            checksum -= ch.query(graph, s, f).GetDistances()[f];
+    });
+    std::cout << "  dijkstraPath: " << dijkstraMs / queries << " ms/query\n"
+              << "  CH query:     " << chMs / queries << " ms/query"
+              << (checksum == 0 ? "" : "  (MISMATCH!)") << "\n";
+}
+
+// -----------------------------------------------------------------
+//  Delta-stepping: масштабирование по числу потоков 1..N против
+//  последовательной Дейкстры до всех вершин
+inline void BenchmarkDeltaStepping(int vertexCount = 1000000, int degree = 4, int sources = 3)
+{
+    CsrGraph<int> graph = MakeRandomGraph(vertexCount, degree, 1000).freeze();
+    std::cout << "Delta-stepping, V = " << vertexCount << ", E = " << graph.edgeCount() << "\n";
+
+    QueryWorkspace ws;
+    double dijkstraMs = MeasureMs([&]{
+        for (int s = 0; s < sources; ++s)
+            shortestPathSearch(graph, s, -1, ws);
+    });
+    std::cout << "  sequential Dijkstra: " << dijkstraMs / sources << " ms/source\n";
+
+    DeltaStepping<int> solver(graph);
+    std::cout << "  delta = " << solver.bucketWidth() << "\n";
+    double oneThreadMs = 0.0;
+    for (int threads = 1; threads <= defaultThreadCount(); ++threads)
+    {
+        ThreadPool pool(threads);
+        double ms = MeasureMs([&]{
+            for (int s = 0; s < sources; ++s)
+                solver.run(s, pool);
+        });
+        if (threads == 1)
+            oneThreadMs = ms;
+        std::cout << "  " << threads << " thread(s): " << ms / sources << " ms/source"
+                  << ", speedup x" << oneThreadMs / ms << "\n";
+    }
+}
+
+// -----------------------------------------------------------------
+//  Матрица расстояний против dijkstraPath на каждую пару
+inline void BenchmarkDistanceMatrix(int side = 300, int points = 100)
+{
+    Graph<int> graph = MakeGridGraph(side, 100);
+    std::cout << "Distance matrix " << points << " x " << points
+              << ", V = " << graph.vertexCount() << "\n";
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> vertexDist(0, graph.vertexCount() - 1);
+    std::vector<int> sample(points);
+    for (int& v : sample)
+        v = vertexDist(rng);
+
+    // Попарно — только первые строки, иначе слишком долго
+    const int pairRows = 2;
+    double pairMs = MeasureMs([&]{
+        for (int r = 0; r < pairRows; ++r)
+            for (int t : sample)
+                graph.dijkstraPath(sample[r], t);
+    });
+    std::cout << "  dijkstraPath per pair: " << pairMs / pairRows << " ms/row\n";
+
+    std::vector<int> threadCounts = {1};
+    if (defaultThreadCount() > 1)
+        threadCounts.push_back(defaultThreadCount());
+
+    DistanceMatrix matrix;
+    for (int threads : threadCounts)
+    {
+        double ms = MeasureMs([&]{ matrix = graph.distanceMatrix(sample, sample, threads); });
+        std::cout << "  distanceMatrix, " << threads << " thread(s): "
+                  << ms / points << " ms/row\n";
+    }
+}
+
+// -----------------------------------------------------------------
+//  Все пары на плотном графе: блочный Флойд — Уоршелл против V запусков
+//  Дейкстры до всех вершин
+inline void BenchmarkAllPairs(int vertexCount = 1500, int degree = 200)
+{
+    Graph<int> graph = MakeRandomGraph(vertexCount, degree, 1000);
+    CsrGraph<int> csr = graph.freeze();
+    std::cout << "All pairs, V = " << vertexCount << ", E = " << csr.edgeCount()
+#if defined(__AVX2__)
+              << ", AVX2 kernel\n";
+#else
+              << ", scalar kernel\n";
+#endif
+
+    QueryWorkspace ws;
+    double dijkstraMs = MeasureMs([&]{
+        for (int s = 0; s < vertexCount; ++s)
+            shortestPathSearch(csr, s, -1, ws);
+    });
+    std::cout << "  V x Dijkstra: " << dijkstraMs << " ms\n";
+
+    for (int threads = 1; threads <= defaultThreadCount(); threads *= 2)
+    {
+        double ms = MeasureMs([&]{ AllPairsShortestPaths<int> apsp(csr, threads); });
+        std::cout << "  blocked Floyd-Warshall, " << threads << " thread(s): " << ms << " ms\n";
+    }
+}
+
+// -----------------------------------------------------------------
+//  k кратчайших путей: граф размера input3.txt (100 вершин) и большая решётка
+inline void BenchmarkKShortestPaths()
+{
+    auto run = [&](const char* label, Graph<int>& graph, int start, int finish) {
+        std::cout << "  " << label << ", V = " << graph.vertexCount() << ":";
+        for (int k : {1, 10, 100})
+        {
+            std::size_t found = 0;
+            double ms = MeasureMs([&]{ found = graph.kShortestPaths(start, finish, k).size(); });
+            std::cout << "  k = " << k << " -> " << ms << " ms (" << found << " paths)";
+        }
+        std::cout << "\n";
+    };
+
+    std::cout << "K shortest paths (Yen)\n";
+    Graph<int> small = MakeRandomGraph(100, 2, 10);
+    run("random like input3.txt", small, 0, 99);
+    Graph<int> grid = MakeGridGraph(100, 100);
+    run("grid 100 x 100", grid, 0, grid.vertexCount() - 1);
+}
+
+// -----------------------------------------------------------------
+//  Починка дерева путей при правках рёбер против полного пересчёта
+inline void BenchmarkDynamicShortestPaths(int side = 300, int updates = 200)
+{
+    Graph<int> graph = MakeGridGraph(side, 100);
+    std::cout << "Dynamic SSSP, V = " << graph.vertexCount() << ", " << updates << " weight changes\n";
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> vertexDist(0, graph.vertexCount() - 2);
+    std::uniform_int_distribution<int> weightDist(1, 100);
+    struct WeightEdit
+    {
+        int from;
+        int to;
+        int weight;
+    };
+    std::vector<WeightEdit> edits(updates);
+    for (auto& e : edits)
+    {
+        int v = vertexDist(rng);
+        e = {v, v + 1 < graph.vertexCount() && (v + 1) % side != 0 ? v + 1 : v - 1, weightDist(rng)};
+    }
+
+    // Обе стороны применяют одни и те же правки к своей копии графа,
+    // так что время правки входит в оба замера
+    Graph<int> rebuilt = graph;
+    DynamicShortestPaths<int> tree(graph, 0);
+    double repairMs = MeasureMs([&]{
+        for (const WeightEdit& e : edits)
+            tree.setEdgeWeight(e.from, e.to, e.weight);
+    });
+
+    QueryWorkspace ws;
+    double recomputeMs = MeasureMs([&]{
+        for (const WeightEdit& e : edits)
+        {
+            rebuilt.removeEdge(e.from, e.to);
+            rebuilt.addEdge(e.from, e.to, e.weight);
+            shortestPathSearch(rebuilt, 0, -1, ws);
+        }
+    });
+    std::cout << "  repair:     " << repairMs / updates << " ms/update\n"
+              << "  recompute:  " << recomputeMs / updates << " ms/update\n";
+}
+
+// -----------------------------------------------------------------
+//  BFS с выбором направления против последовательного BFS
+//  (тот же движок, что у Graph<T>::breadthFirstSearch) на степенном графе
+
+// R-MAT (Chakrabarti, Zhan, Faloutsos): ребро в графе из 2^scale вершин
+// спускается по четвертям матрицы смежности с вероятностями
+// a, b, c, d = 0.57, 0.19, 0.19, 0.05, что даёт степенное
+// распределение степеней
+inline Edge MakeRmatEdge(std::mt19937& rng, int scale)
+{
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    int u = 0, v = 0;
+    for (int bit = scale - 1; bit >= 0; --bit)
+    {
+        double r = coin(rng);
+        if (r < 0.57)
+            continue;
+        if (r < 0.76)
+            v |= 1 << bit;
+        else if (r < 0.95)
+            u |= 1 << bit;
+        else
+        {
+            u |= 1 << bit;
+            v |= 1 << bit;
+        }
+    }
+    return Edge(u, v, 1.0);
+}
+
+// R-MAT граф с edgeCount рёбрами веса 1; CSR строится сразу, без Graph<int>
+inline CsrGraph<int> MakePowerLawGraph(int scale, long long edgeCount, unsigned seed = 42)
+{
+    std::mt19937 rng(seed);
+    const int n = 1 << scale;
+
+    std::vector<int> names(n);
+    for (int i = 0; i < n; ++i)
+        names[i] = i;
+
+    std::vector<Edge> edges;
+    edges.reserve(edgeCount);
+    for (long long e = 0; e < edgeCount; ++e)
+        edges.push_back(MakeRmatEdge(rng, scale));
+    return CsrGraph<int>(std::move(names), edges);
+}
+
+inline void BenchmarkParallelBfs(int scale = 20, long long edgeCount = 10000000, int sources = 4)
+{
+    CsrGraph<int> graph = MakePowerLawGraph(scale, edgeCount);
+    std::cout << "Direction-optimizing BFS, V = " << graph.vertexCount()
+              << ", E = " << graph.edgeCount() << "\n";
+
+    // Источники — вершины с исходящими рёбрами (у R-MAT много изолированных)
+    std::vector<int> starts;
+    for (int v = 0; static_cast<int>(starts.size()) < sources && v < graph.vertexCount(); v += 997)
+    {
+        if (graph.outDegree(v) > 0)
+            starts.push_back(v);
+    }
+
+    QueryWorkspace ws;
+    double sequentialMs = MeasureMs([&]{
+        for (int s : starts)
+            breadthFirstTraversal(graph, s, {}, ws);
+    });
+    std::cout << "  sequential BFS: " << sequentialMs / starts.size() << " ms/source\n";
+
+    DirectionOptimizingBfs<int> bfs;
+    for (int threads = 1; threads <= defaultThreadCount(); ++threads)
+    {
+        ThreadPool pool(threads);
+        BfsStats stats;
+        double ms = MeasureMs([&]{
+            for (int s : starts)
+                bfs.run(graph, s, pool, &stats);
+        });
+        std::cout << "  " << threads << " thread(s): " << ms / starts.size() << " ms/source"
+                  << ", speedup x" << sequentialMs / ms
+                  << " (top-down " << stats.topDownSteps << ", bottom-up "
+                  << stats.bottomUpSteps << " steps)\n";
+    }
+}
+
+// -----------------------------------------------------------------
+//  MS-BFS против отдельного BFS на каждый источник (близость для пачки
+//  источников на степенном графе)
+inline void BenchmarkMultiSourceBfs(int scale = 18, long long edgeCount = 2000000, int sources = 512)
+{
+    CsrGraph<int> graph = MakePowerLawGraph(scale, edgeCount);
+    std::cout << "Multi-source BFS, V = " << graph.vertexCount() << ", E = " << graph.edgeCount()
+              << ", sources = " << sources << "\n";
+
+    std::vector<int> starts;
+    for (int v = 0; static_cast<int>(starts.size()) < sources && v < graph.vertexCount(); ++v)
+    {
+        if (graph.outDegree(v) > 0)
+            starts.push_back(v);
+    }
+
+    QueryWorkspace ws;
+    TraversalOptions depths;
+    depths.depths = true;
+    long long checksum = 0;
+    double singleMs = MeasureMs([&]{
+        for (int s : starts)
+        {
+            TraversalResult r = breadthFirstTraversal(graph, s, depths, ws);
+            for (int v : r.order)
+                checksum += r.depth[v];
+        }
+    });
+    std::cout << "  BFS per source: " << singleMs << " ms\n";
+
+    auto measure = [&](const char* label, auto&& solver) {
+        long long sum = 0;
+        double ms = MeasureMs([&]{
+            MultiSourceBfsResult result = solver.run(graph, starts, false, 1);
+            for (long long d : result.distanceSum)
+                sum += d;
+        });
+        std::cout << label << ms << " ms, speedup x" << singleMs / ms
+                  << (sum == checksum ? "" : " (MISMATCH)") << "\n";
+    };
+    measure("  MS-BFS, 64 bits:  ", MultiSourceBfs<int, 64>());
+    measure("  MS-BFS, 256 bits: ", MultiSourceBfs<int, 256>());
+}
+
+// -----------------------------------------------------------------
+//  Компоненты слабой связности: Afforest по CSR (масштабирование по
+//  потокам против полного union-find по всем рёбрам) и потоковый
+//  union-find на streamEdges рёбрах, которые целиком в памяти не лежат
+inline void BenchmarkComponents(int scale = 21, long long edgeCount = 20000000,
+                                long long streamEdges = 100000000)
+{
+    CsrGraph<int> graph = MakePowerLawGraph(scale, edgeCount);
+    std::cout << "Weakly connected components, V = " << graph.vertexCount()
+              << ", E = " << graph.edgeCount() << "\n";
+
+    // Все рёбра по разу, один поток
+    double fullMs = MeasureMs([&]{
+        ConcurrentUnionFind forest(graph.vertexCount());
+        for (int u = 0; u < graph.vertexCount(); ++u)
+        {
+            for (int k = 0; k < graph.outDegree(u); ++k)
+                forest.link(u, graph.outTarget(u, k));
+        }
+        forest.compress(1);
+    });
+    std::cout << "  union-find over all edges: " << fullMs << " ms\n";
+
+    for (int threads = 1; threads <= defaultThreadCount(); ++threads)
+    {
+        int count = 0;
+        double ms = MeasureMs([&]{
+            count = afforestComponents(graph, threads).count();
+        });
+        std::cout << "  Afforest, " << threads << " thread(s): " << ms << " ms, speedup x"
+                  << fullMs / ms << ", " << count << " components\n";
+    }
+
+    // Потоковый режим: случайные рёбра пачками по миллиону; время
+    // генерации рёбер вычитается
+    const int streamVertices = 1 << 24;
+    const std::size_t chunk = 1000000;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> vertexDist(0, streamVertices - 1);
+    long long produced = 0;
+    double generateMs = 0.0;
+    int count = 0;
+    double streamMs = MeasureMs([&]{
+        count = streamComponents(streamVertices, [&](std::vector<Edge>& buffer) {
+            generateMs += MeasureMs([&]{
+                while (buffer.size() < chunk && produced < streamEdges)
+                {
+                    buffer.emplace_back(vertexDist(rng), vertexDist(rng), 1.0);
+                    ++produced;
+                }
+            });
+            return produced < streamEdges;
+        }).count();
+    });
+    std::cout << "  streamed, V = " << streamVertices << ", E = " << streamEdges << ": "
+              << streamMs - generateMs << " ms, " << count << " components\n";
+}
+
+inline void RunBenchmarks()
+{
+    BenchmarkHeaps();
+    BenchmarkSmallWeights();
+    BenchmarkContractionHierarchy();
+    BenchmarkDeltaStepping();
+    BenchmarkDistanceMatrix();
+    BenchmarkAllPairs();
+    BenchmarkKShortestPaths();
+    BenchmarkDynamicShortestPaths();
+    BenchmarkParallelBfs();
+    BenchmarkMultiSourceBfs();
+    BenchmarkComponents();
+}
+
+#endif // LAB4_BENCHMARKS
@@ -0,0 +1,151 @@
+#ifndef BIDIRECTIONAL_DIJKSTRA_H
+#define BIDIRECTIONAL_DIJKSTRA_H
+
+#include <vector>
+#include <limits>
+#include "Path.h"
+#include "DynamicArray.h"
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+
+// Двусторонняя Дейкстра для запросов «точка — точка».
+// Прямой поиск идёт из start по out-рёбрам, обратный — из finish
+// по in-рёбрам (G должен уметь forEachIn). mu — длина лучшего найденного
+// пути через вершину, помеченную обоими поисками; поиск останавливается,
+// когда сумма последних извлечённых ключей обеих сторон достигает mu.
+// На больших разреженных графах каждая сторона проходит «шар» вдвое
+// меньшего радиуса, и вершин извлекается намного меньше.
+
+// Возвращает вершину встречи (-1, если finish недостижим).
+// Кратчайший путь: start .. meet по fw.parent, meet .. finish по bw.parent.
+template<typename Heap = DefaultDijkstraHeap, typename G>
+int bidirectionalSearch(const G& graph, int start, int finish,
+                        QueryWorkspace& fw, QueryWorkspace& bw,
+                        Heap& fwHeap = localQueue<Heap>(0),
+                        Heap& bwHeap = localQueue<Heap>(1))
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    fw.reset(graph.vertexCount());
+    bw.reset(graph.vertexCount());
+    fwHeap.clear();
+    bwHeap.clear();
+
+    fw.setLabel(start, 0.0, -1);
+    bw.setLabel(finish, 0.0, -1);
+    if (start == finish)
+        return start;
+
+    fwHeap.push(start, 0.0);
+    bwHeap.push(finish, 0.0);
+
+    double mu = INF;
+    int meet = -1;
+    double fwLast = 0.0;   // последний извлечённый ключ каждой стороны
+    double bwLast = 0.0;
+
+    // Шаг одной стороны; false — пора останавливаться
+    auto step = [&](bool forward) {
+        Heap& heap = forward ? fwHeap : bwHeap;
+        QueryWorkspace& self = forward ? fw : bw;
+        QueryWorkspace& other = forward ? bw : fw;
+
+        auto [curDist, cur] = heap.pop();
+        if (curDist > self.distance(cur))
+            return true;
+        if (curDist + (forward ? bwLast : fwLast) >= mu)
+            return false;
+        (forward ? fwLast : bwLast) = curDist;
+
+        auto relax = [&](int neigh, double weight) {
+            double alt = curDist + weight;
+            if (alt < self.distance(neigh))
+            {
+                self.setLabel(neigh, alt, cur);
+                heap.push(neigh, alt);
+            }
+            if (other.touched(neigh))
+            {
+                double through = self.distance(neigh) + other.distance(neigh);
+                if (through < mu)
+                {
+                    mu = through;
+                    meet = neigh;
+                }
+            }
+        };
+        if (forward)
+            graph.forEachOut(cur, relax);
+        else
+            graph.forEachIn(cur, relax);
+        return true;
+    };
+
+    // Ходит сторона с меньшей очередью — фронты растут равномерно
+    while (!fwHeap.empty() && !bwHeap.empty())
+    {
+        if (!step(fwHeap.size() <= bwHeap.size()))
+            break;
+    }
+    return meet;
+}
+
+// Выбор очереди по весам графа, как в shortestPathSearch
+template<typename G>
+int bidirectionalShortestPathSearch(const G& graph, int start, int finish,
+                                    QueryWorkspace& fw, QueryWorkspace& bw)
+{
+    if (graph.hasSmallIntWeights())
+        return bidirectionalSearch<BucketQueue>(graph, start, finish, fw, bw);
+    return bidirectionalSearch(graph, start, finish, fw, bw);
+}
+
+// Упаковка результата в Path<T>. Расстояния — метки прямого поиска
+// (как и у обычной Дейкстры с ранней остановкой, точны не для всех
+// вершин), для вершин найденного пути — точные длины от start.
+template<typename T, typename G>
+Path<T> makeBidirectionalPath(const G& graph, int meet,
+                              const QueryWorkspace& fw, const QueryWorkspace& bw)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    const int n = graph.vertexCount();
+
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+    for (int i = 0; i < n; ++i)
+    {
+        double d = fw.distance(i);
+        distArr.push_back(d == INF ? -1 : static_cast<int>(d));
+    }
+    if (meet < 0)
+        return Path<T>(std::move(distArr), std::move(pathArr));
+
+    // start .. meet (в обратном порядке, затем разворачиваем)
+    std::vector<int> route;
+    for (int v = meet; v != -1; v = fw.parent(v))
+        route.push_back(v);
+    for (std::size_t l = 0, r = route.size() - 1; l < r; ++l, --r)
+        std::swap(route[l], route[r]);
+
+    // meet .. finish: обратное дерево хранит «следующую» вершину к финишу.
+    // Длины копим по весам рёбер в прямом порядке, а не вычитаем метки
+    // обратного поиска, чтобы округление совпало с обычной Дейкстрой
+    double d = fw.distance(meet);
+    for (int cur = meet, v = bw.parent(meet); v != -1; cur = v, v = bw.parent(v))
+    {
+        double step = std::numeric_limits<double>::infinity();
+        graph.forEachOut(cur, [&](int neigh, double weight){
+            if (neigh == v && weight < step)
+                step = weight;
+        });
+        d += step;
+        route.push_back(v);
+        distArr[v] = static_cast<int>(d);
+    }
+
+    for (int v : route)
+        pathArr.push_back(graph.vertexName(v));
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+#endif // BIDIRECTIONAL_DIJKSTRA_H
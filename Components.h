@@ -0,0 +1,227 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <atomic>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_map>
+#include "Edge.h"
+#include "Parallel.h"
+
+// Компоненты слабой связности: параллельный union-find без блокировок
+// и алгоритм Afforest (Sutton, Ben-Nun, Barak).
+// Лес хранится одним массивом parent; корень — вершина с parent[v] == v.
+// link(u, v) подвешивает больший корень к меньшему через CAS, поэтому
+// потоки могут объединять множества одновременно, а find по дороге
+// делит пути пополам; compress() в конце сжимает пути, и parent[v]
+// становится корнем.
+// Afforest не обрабатывает все рёбра подряд: сначала по NEIGHBOR_ROUNDS
+// первых соседей каждой вершины (этого обычно хватает, чтобы собрать
+// гигантскую компоненту), затем выборкой находится самая большая
+// компонента, и оставшиеся рёбра просматриваются только у вершин вне её.
+
+class ConcurrentUnionFind
+{
+private:
+    std::vector<std::atomic<int>> parent;
+
+public:
+    explicit ConcurrentUnionFind(int vertexCount = 0)
+        : parent(vertexCount)
+    {
+        for (int v = 0; v < vertexCount; ++v)
+            parent[v].store(v, std::memory_order_relaxed);
+    }
+
+    int size() const { return static_cast<int>(parent.size()); }
+
+    // Корень с делением пути пополам: каждая пройденная вершина
+    // перевешивается на деда. CAS может проиграть другому потоку — это
+    // не страшно, любой предок по-прежнему в том же множестве
+    int find(int v)
+    {
+        while (true)
+        {
+            int p = parent[v].load(std::memory_order_relaxed);
+            int gp = parent[p].load(std::memory_order_relaxed);
+            if (p == gp)
+                return p;
+            parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            v = gp;
+        }
+    }
+
+    void link(int u, int v)
+    {
+        while (true)
+        {
+            const int ru = find(u);
+            const int rv = find(v);
+            if (ru == rv)
+                return;
+            // Больший корень подвешивается к меньшему; если его успели
+            // подвесить к чему-то другому, ищем корни заново
+            const int high = std::max(ru, rv);
+            int expected = high;
+            if (parent[high].compare_exchange_strong(expected, std::min(ru, rv),
+                                                     std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    // Сжатие путей: после него parent[v] — корень (вызывать без link)
+    void compress(int threadCount = defaultThreadCount())
+    {
+        forEachVertexChunk(size(), threadCount, [&](int v) {
+            int p = parent[v].load(std::memory_order_relaxed);
+            int pp = parent[p].load(std::memory_order_relaxed);
+            while (p != pp)
+            {
+                parent[v].store(pp, std::memory_order_relaxed);
+                p = pp;
+                pp = parent[p].load(std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Корень после compress()
+    int root(int v) const { return parent[v].load(std::memory_order_relaxed); }
+
+    // Пачка рёбер (направление не важно), параллельно
+    void linkEdges(const Edge* edges, std::size_t count, int threadCount = defaultThreadCount())
+    {
+        const std::size_t chunk = 1 << 14;
+        const int chunks = static_cast<int>((count + chunk - 1) / chunk);
+        parallelFor(chunks, threadCount, [&](int c) {
+            const std::size_t end = std::min(count, (c + 1) * chunk);
+            for (std::size_t i = c * chunk; i < end; ++i)
+                link(edges[i].start, edges[i].finish);
+        });
+    }
+
+    // body(v) для всех вершин, по отрезкам (параллельно)
+    template<typename F>
+    static void forEachVertexChunk(int vertexCount, int threadCount, F&& body)
+    {
+        const int chunk = 4096;
+        parallelFor((vertexCount + chunk - 1) / chunk, threadCount, [&](int c) {
+            const int end = std::min(vertexCount, (c + 1) * chunk);
+            for (int v = c * chunk; v < end; ++v)
+                body(v);
+        });
+    }
+};
+
+struct ComponentsResult
+{
+    std::vector<int> component;   // по вершине: номер компоненты 0..count-1
+    std::vector<int> sizes;       // по номеру компоненты: число вершин
+
+    int count() const { return static_cast<int>(sizes.size()); }
+};
+
+// Плотные номера по сжатому лесу: компоненты нумеруются в порядке
+// наименьшей вершины (корень — как раз наименьшая вершина множества)
+inline ComponentsResult denseComponents(const ConcurrentUnionFind& forest)
+{
+    const int n = forest.size();
+    ComponentsResult result;
+    result.component.assign(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        const int r = forest.root(v);
+        if (r == v)
+        {
+            result.component[v] = result.count();
+            result.sizes.push_back(0);
+        }
+        const int id = result.component[r];
+        result.component[v] = id;
+        ++result.sizes[id];
+    }
+    return result;
+}
+
+// Afforest на графе с плотными индексами: G даёт vertexCount,
+// outDegree/outTarget и inDegree/inSource (Graph<T>, CsrGraph<T>)
+template<typename G>
+ComponentsResult afforestComponents(const G& graph, int threadCount = defaultThreadCount())
+{
+    constexpr int NEIGHBOR_ROUNDS = 2;
+    constexpr int SAMPLES = 1024;
+
+    const int n = graph.vertexCount();
+    ConcurrentUnionFind forest(n);
+    if (n == 0)
+        return denseComponents(forest);
+
+    // 1) Первые соседи: по одному раунду на номер ребра
+    for (int r = 0; r < NEIGHBOR_ROUNDS; ++r)
+    {
+        ConcurrentUnionFind::forEachVertexChunk(n, threadCount, [&](int v) {
+            if (r < graph.outDegree(v))
+                forest.link(v, graph.outTarget(v, r));
+        });
+        forest.compress(threadCount);
+    }
+
+    // 2) Самая частая компонента по выборке
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::unordered_map<int, int> frequency;
+    int largest = forest.root(0);
+    int best = 0;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const int c = forest.root(pick(rng));
+        if (++frequency[c] > best)
+        {
+            best = frequency[c];
+            largest = c;
+        }
+    }
+
+    // 3) Остальные рёбра — только у вершин вне largest. Ребро x -> u
+    //    из largest в u найдётся среди входящих u, поэтому входящие
+    //    рёбра таких вершин просматриваются целиком
+    ConcurrentUnionFind::forEachVertexChunk(n, threadCount, [&](int v) {
+        if (forest.find(v) == largest)
+            return;
+        const int outDegree = graph.outDegree(v);
+        for (int k = NEIGHBOR_ROUNDS; k < outDegree; ++k)
+            forest.link(v, graph.outTarget(v, k));
+        const int inDegree = graph.inDegree(v);
+        for (int k = 0; k < inDegree; ++k)
+            forest.link(v, graph.inSource(v, k));
+    });
+    forest.compress(threadCount);
+    return denseComponents(forest);
+}
+
+// Рёбра, которые не помещаются в память целиком (файл, генератор):
+// readChunk(buffer) заполняет buffer следующей пачкой и возвращает
+// false, когда рёбер больше нет. В памяти — лес (4 байта на вершину)
+// и одна пачка; каждая пачка объединяется параллельно
+template<typename Reader>
+ComponentsResult streamComponents(int vertexCount, Reader&& readChunk,
+                                  int threadCount = defaultThreadCount())
+{
+    ConcurrentUnionFind forest(vertexCount);
+    std::vector<Edge> buffer;
+    while (true)
+    {
+        buffer.clear();
+        const bool more = readChunk(buffer);
+        forest.linkEdges(buffer.data(), buffer.size(), threadCount);
+        if (!more)
+            break;
+    }
+    forest.compress(threadCount);
+    return denseComponents(forest);
+}
+
+#endif // COMPONENTS_H
@@ -0,0 +1,421 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <queue>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include "CsrGraph.h"
+#include "Path.h"
+#include "DynamicArray.h"
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+
+// Иерархия сжатий (contraction hierarchies) для статичных «дорожных»
+// графов.
+// Предобработка по одной «сжимает» вершины в порядке важности: вершина v
+// удаляется, а для каждой пары соседей u -> v -> x, между которыми нет
+// другого пути не длиннее (поиск свидетеля), добавляется ярлык u -> x.
+// Порядок — по разности рёбер (ярлыков добавится минус рёбер уйдёт)
+// плюс число уже сжатых соседей, с ленивым пересчётом приоритетов.
+// Запрос — двусторонняя Дейкстра только «вверх» по рангу; найденные
+// ярлыки разворачиваются обратно в рёбра исходного графа.
+// Как и LandmarkIndex, привязана к индексам конкретного CsrGraph<T>.
+
+template<typename T>
+class ContractionHierarchy
+{
+private:
+    // Дуга на время предобработки: middle — сжатая вершина ярлыка
+    // (-1 у исходного ребра)
+    struct Arc
+    {
+        int to;
+        double weight;
+        int middle;
+    };
+
+    int vertexCount = 0;
+    int edgeCount = 0;                // вместе с vertexCount — проверка, что граф тот же
+    int shortcuts = 0;
+    std::vector<int> rank;            // порядковый номер сжатия
+
+    // «Вверх» из u: дуги u -> x с rank[x] > rank[u]
+    std::vector<int> upOffsets;
+    std::vector<int> upTargets;
+    std::vector<double> upWeights;
+    std::vector<int> upMiddles;
+
+    // «Вверх» для обратного поиска из x: дуги u -> x с rank[u] > rank[x]
+    std::vector<int> downOffsets;
+    std::vector<int> downSources;
+    std::vector<double> downWeights;
+    std::vector<int> downMiddles;
+
+    // Дуги «вверх» одной стороны запроса. Сам поиск — свой шаг step в
+    // query (двусторонний, с остановкой по mu), а не dijkstraSearch:
+    // UpwardGraph только даёт обоим направлениям общий forEachOut
+    struct UpwardGraph
+    {
+        const std::vector<int>& offsets;
+        const std::vector<int>& heads;
+        const std::vector<double>& weights;
+
+        template<typename F>
+        void forEachOut(int u, F&& f) const
+        {
+            for (int k = offsets[u]; k < offsets[u + 1]; ++k)
+                f(heads[k], weights[k]);
+        }
+    };
+
+    // -- Предобработка --
+
+    static void addArc(std::vector<Arc>& arcs, int to, double weight, int middle)
+    {
+        for (Arc& a : arcs)
+        {
+            if (a.to == to)
+            {
+                if (weight < a.weight)
+                {
+                    a.weight = weight;
+                    a.middle = middle;
+                }
+                return;
+            }
+        }
+        arcs.push_back({to, weight, middle});
+    }
+
+    // Поиск свидетелей из u в оставшемся графе без вершины skip:
+    // останавливаемся за пределом limit или после settleLimit вершин
+    void witnessSearch(const std::vector<std::vector<Arc>>& out,
+                       const std::vector<char>& contracted,
+                       int u, int skip, double limit, QueryWorkspace& ws) const
+    {
+        const int settleLimit = 500;
+        LazyHeap& heap = localQueue<LazyHeap>();
+        ws.reset(vertexCount);
+        heap.clear();
+        ws.setLabel(u, 0.0, -1);
+        heap.push(u, 0.0);
+
+        int settled = 0;
+        while (!heap.empty())
+        {
+            auto [d, cur] = heap.pop();
+            if (d > ws.distance(cur))
+                continue;
+            if (d > limit || ++settled > settleLimit)
+                break;
+            for (const Arc& a : out[cur])
+            {
+                if (a.to == skip || contracted[a.to])
+                    continue;
+                double alt = d + a.weight;
+                if (alt < ws.distance(a.to))
+                {
+                    ws.setLabel(a.to, alt, cur);
+                    heap.push(a.to, alt);
+                }
+            }
+        }
+    }
+
+    // Ярлыки, нужные при сжатии v; apply = false — только подсчёт
+    int contract(std::vector<std::vector<Arc>>& out, std::vector<std::vector<Arc>>& in,
+                 const std::vector<char>& contracted, int v, bool apply, QueryWorkspace& ws)
+    {
+        int added = 0;
+        for (const Arc& a : in[v])
+        {
+            int u = a.to;
+            if (contracted[u] || u == v)
+                continue;
+
+            double limit = -1.0;
+            for (const Arc& b : out[v])
+            {
+                if (!contracted[b.to] && b.to != u && b.to != v)
+                    limit = std::max(limit, a.weight + b.weight);
+            }
+            if (limit < 0.0)
+                continue;  // идти из v некуда
+
+            witnessSearch(out, contracted, u, v, limit, ws);
+            for (const Arc& b : out[v])
+            {
+                int x = b.to;
+                if (contracted[x] || x == u || x == v)
+                    continue;
+                double through = a.weight + b.weight;
+                if (ws.distance(x) <= through)
+                    continue;  // есть свидетель
+                ++added;
+                if (apply)
+                {
+                    addArc(out[u], x, through, v);
+                    addArc(in[x], u, through, v);
+                }
+            }
+        }
+        return added;
+    }
+
+    // Дуга a -> b иерархии: (вес, середина)
+    std::pair<double, int> findArc(int a, int b) const
+    {
+        std::pair<double, int> best{std::numeric_limits<double>::infinity(), -1};
+        if (rank[a] < rank[b])
+        {
+            for (int k = upOffsets[a]; k < upOffsets[a + 1]; ++k)
+            {
+                if (upTargets[k] == b && upWeights[k] < best.first)
+                    best = {upWeights[k], upMiddles[k]};
+            }
+        }
+        else
+        {
+            for (int k = downOffsets[b]; k < downOffsets[b + 1]; ++k)
+            {
+                if (downSources[k] == a && downWeights[k] < best.first)
+                    best = {downWeights[k], downMiddles[k]};
+            }
+        }
+        return best;
+    }
+
+public:
+    ContractionHierarchy() = default;
+
+    explicit ContractionHierarchy(const CsrGraph<T>& graph)
+        : vertexCount(graph.vertexCount()), edgeCount(graph.edgeCount()),
+          rank(graph.vertexCount(), -1)
+    {
+        const int n = vertexCount;
+        std::vector<std::vector<Arc>> out(n);
+        std::vector<std::vector<Arc>> in(n);
+        for (int u = 0; u < n; ++u)
+        {
+            graph.forEachOut(u, [&](int v, double w){
+                if (w < 0.0)
+                    throw std::runtime_error("Иерархия сжатий не поддерживает отрицательные веса.");
+                if (u == v)
+                    return;  // петли кратчайшим путям не нужны
+                addArc(out[u], v, w, -1);
+                addArc(in[v], u, w, -1);
+            });
+        }
+
+        std::vector<char> contracted(n, 0);
+        std::vector<int> contractedNeighbors(n, 0);
+        QueryWorkspace& ws = QueryWorkspace::local();
+
+        auto priority = [&](int v) {
+            int degree = 0;
+            for (const Arc& a : in[v])
+                degree += !contracted[a.to];
+            for (const Arc& a : out[v])
+                degree += !contracted[a.to];
+            int needed = contract(out, in, contracted, v, false, ws);
+            return (needed - degree) + contractedNeighbors[v];
+        };
+
+        using Item = std::pair<int, int>;  // (приоритет, вершина)
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> order;
+        for (int v = 0; v < n; ++v)
+            order.push({priority(v), v});
+
+        int nextRank = 0;
+        while (!order.empty())
+        {
+            auto [p, v] = order.top();
+            order.pop();
+            if (contracted[v])
+                continue;
+
+            // Ленивое обновление: приоритет мог вырасти после соседних сжатий
+            int current = priority(v);
+            if (!order.empty() && current > order.top().first)
+            {
+                order.push({current, v});
+                continue;
+            }
+
+            shortcuts += contract(out, in, contracted, v, true, ws);
+            contracted[v] = 1;
+            rank[v] = nextRank++;
+            for (const Arc& a : out[v])
+                ++contractedNeighbors[a.to];
+            for (const Arc& a : in[v])
+                ++contractedNeighbors[a.to];
+        }
+
+        // Раскладываем все дуги (рёбра + ярлыки) по двум CSR «вверх»
+        upOffsets.assign(n + 1, 0);
+        downOffsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u)
+        {
+            for (const Arc& a : out[u])
+            {
+                if (rank[u] < rank[a.to])
+                    ++upOffsets[u + 1];
+                else
+                    ++downOffsets[a.to + 1];
+            }
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            upOffsets[i + 1] += upOffsets[i];
+            downOffsets[i + 1] += downOffsets[i];
+        }
+        upTargets.resize(upOffsets[n]);
+        upWeights.resize(upOffsets[n]);
+        upMiddles.resize(upOffsets[n]);
+        downSources.resize(downOffsets[n]);
+        downWeights.resize(downOffsets[n]);
+        downMiddles.resize(downOffsets[n]);
+
+        std::vector<int> upPos(upOffsets.begin(), upOffsets.end() - 1);
+        std::vector<int> downPos(downOffsets.begin(), downOffsets.end() - 1);
+        for (int u = 0; u < n; ++u)
+        {
+            for (const Arc& a : out[u])
+            {
+                if (rank[u] < rank[a.to])
+                {
+                    int k = upPos[u]++;
+                    upTargets[k] = a.to;
+                    upWeights[k] = a.weight;
+                    upMiddles[k] = a.middle;
+                }
+                else
+                {
+                    int k = downPos[a.to]++;
+                    downSources[k] = u;
+                    downWeights[k] = a.weight;
+                    downMiddles[k] = a.middle;
+                }
+            }
+        }
+    }
+
+    int shortcutCount() const { return shortcuts; }
+    int vertexRank(int v) const { return rank[v]; }
+
+    // Запрос «точка — точка». Расстояния в Path<T> известны только для
+    // вершин найденного пути (остальные -1): поиск «вверх» не считает
+    // кратчайшие расстояния до прочих вершин.
+    Path<T> query(const CsrGraph<T>& graph, const T& startName, const T& finishName,
+                  QueryWorkspace& fw = QueryWorkspace::local(0),
+                  QueryWorkspace& bw = QueryWorkspace::local(1)) const
+    {
+        if (graph.vertexCount() != vertexCount || graph.edgeCount() != edgeCount)
+            throw std::runtime_error("Иерархия сжатий построена для другого графа.");
+
+        const int start = graph.indexOf(startName);
+        const int finish = graph.indexOf(finishName);
+        if (start < 0 || finish < 0)
+            return makeMissingPath<T>(vertexCount);
+
+        const double INF = std::numeric_limits<double>::infinity();
+        UpwardGraph up{upOffsets, upTargets, upWeights};
+        UpwardGraph down{downOffsets, downSources, downWeights};
+        LazyHeap& fwHeap = localQueue<LazyHeap>(0);
+        LazyHeap& bwHeap = localQueue<LazyHeap>(1);
+
+        fw.reset(vertexCount);
+        bw.reset(vertexCount);
+        fwHeap.clear();
+        bwHeap.clear();
+        fw.setLabel(start, 0.0, -1);
+        bw.setLabel(finish, 0.0, -1);
+        fwHeap.push(start, 0.0);
+        bwHeap.push(finish, 0.0);
+
+        double mu = INF;
+        int meet = -1;
+
+        // Сторона останавливается, когда её минимальный ключ не меньше mu
+        auto step = [&](const UpwardGraph& g, LazyHeap& heap,
+                        QueryWorkspace& self, const QueryWorkspace& other) {
+            auto [d, cur] = heap.pop();
+            if (d > self.distance(cur))
+                return;
+            if (d >= mu)
+            {
+                heap.clear();
+                return;
+            }
+            if (other.touched(cur) && d + other.distance(cur) < mu)
+            {
+                mu = d + other.distance(cur);
+                meet = cur;
+            }
+            g.forEachOut(cur, [&](int next, double w){
+                double alt = d + w;
+                if (alt < self.distance(next))
+                {
+                    self.setLabel(next, alt, cur);
+                    heap.push(next, alt);
+                }
+            });
+        };
+
+        while (!fwHeap.empty() || !bwHeap.empty())
+        {
+            if (!fwHeap.empty())
+                step(up, fwHeap, fw, bw);
+            if (!bwHeap.empty())
+                step(down, bwHeap, bw, fw);
+        }
+
+        DynamicArray<int> distArr;
+        DynamicArray<T> pathArr;
+        for (int i = 0; i < vertexCount; ++i)
+            distArr.push_back(-1);
+        if (meet < 0)
+            return Path<T>(std::move(distArr), std::move(pathArr));
+
+        // Цепочка дуг иерархии start .. meet .. finish
+        std::vector<int> chain;
+        for (int v = meet; v != -1; v = fw.parent(v))
+            chain.push_back(v);
+        for (std::size_t l = 0, r = chain.size() - 1; l < r; ++l, --r)
+            std::swap(chain[l], chain[r]);
+        for (int v = bw.parent(meet); v != -1; v = bw.parent(v))
+            chain.push_back(v);
+
+        // Разворачиваем ярлыки: (a, b) с серединой m -> (a, m), (m, b)
+        double total = 0.0;
+        distArr[start] = 0;
+        pathArr.push_back(graph.vertexName(start));
+        std::vector<std::pair<int, int>> stack;
+        for (std::size_t i = chain.size() - 1; i > 0; --i)
+            stack.push_back({chain[i - 1], chain[i]});
+        while (!stack.empty())
+        {
+            auto [a, b] = stack.back();
+            stack.pop_back();
+            auto [w, middle] = findArc(a, b);
+            if (middle < 0)
+            {
+                total += w;
+                distArr[b] = static_cast<int>(total);
+                pathArr.push_back(graph.vertexName(b));
+            }
+            else
+            {
+                stack.push_back({middle, b});
+                stack.push_back({a, middle});
+            }
+        }
+        return Path<T>(std::move(distArr), std::move(pathArr));
+    }
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -0,0 +1,273 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <stdexcept>
+#include <utility>
+#include <unordered_map>
+#include "Edge.h"
+#include "Path.h"
+#include "Dijkstra.h"
+#include "QueryWorkspace.h"
+#include "BidirectionalDijkstra.h"
+#include "DistanceMatrix.h"
+#include "NegativeWeights.h"
+#include "KShortestPaths.h"
+#include "Traversal.h"
+
+// Неизменяемый «снимок» графа в формате CSR (compressed sparse row).
+// Соседи вершины u лежат подряд в outTargets/outWeights
+// на отрезке [outOffsets[u], outOffsets[u + 1]); для входящих рёбер
+// хранится такой же обратный CSR. Индексы вершин совпадают
+// с индексами в Graph<T>::vertices на момент построения.
+// Строится за O(V + E) (сортировка подсчётом), поэтому после пачки
+// правок его дешевле пересобрать через Graph<T>::freeze(), чем править.
+
+template<typename T>
+class CsrGraph
+{
+private:
+    std::vector<T> names;                 // индекс -> имя
+    std::unordered_map<T, int> indices;   // имя -> индекс
+
+    std::vector<int> outOffsets;          // V + 1 смещений
+    std::vector<int> outTargets;          // концы исходящих рёбер
+    std::vector<double> outWeights;
+
+    std::vector<int> inOffsets;           // V + 1 смещений
+    std::vector<int> inSources;           // начала входящих рёбер
+    std::vector<double> inWeights;
+
+    bool smallIntWeights = true;          // все веса подходят для BucketQueue
+    bool negativeWeights = false;         // есть рёбра с отрицательным весом
+    bool negativeCycle = false;
+    std::vector<double> potentials;       // потенциалы Джонсона (только при negativeWeights)
+
+    void requireNoNegativeCycle() const
+    {
+        if (negativeCycle)
+            throw std::runtime_error("В графе есть цикл отрицательного веса.");
+    }
+
+public:
+    CsrGraph() = default;
+
+    // names[i] — имя вершины с индексом i, рёбра ссылаются на эти индексы
+    CsrGraph(std::vector<T> vertexNames, const std::vector<Edge>& edges)
+        : names(std::move(vertexNames))
+    {
+        const int n = static_cast<int>(names.size());
+        indices.reserve(names.size());
+        for (int i = 0; i < n; ++i)
+            indices.emplace(names[i], i);
+
+        outOffsets.assign(n + 1, 0);
+        inOffsets.assign(n + 1, 0);
+        for (const Edge& e : edges)
+        {
+            ++outOffsets[e.start + 1];
+            ++inOffsets[e.finish + 1];
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            outOffsets[i + 1] += outOffsets[i];
+            inOffsets[i + 1] += inOffsets[i];
+        }
+
+        outTargets.resize(edges.size());
+        outWeights.resize(edges.size());
+        inSources.resize(edges.size());
+        inWeights.resize(edges.size());
+
+        // Раскладываем рёбра по своим отрезкам; порядок внутри отрезка
+        // совпадает с порядком добавления, как и в Vertex<T>::out
+        std::vector<int> outPos(outOffsets.begin(), outOffsets.end() - 1);
+        std::vector<int> inPos(inOffsets.begin(), inOffsets.end() - 1);
+        for (const Edge& e : edges)
+        {
+            int o = outPos[e.start]++;
+            outTargets[o] = e.finish;
+            outWeights[o] = e.weight;
+
+            int i = inPos[e.finish]++;
+            inSources[i] = e.start;
+            inWeights[i] = e.weight;
+
+            if (!BucketQueue::accepts(e.weight))
+                smallIntWeights = false;
+            if (e.weight < 0.0)
+                negativeWeights = true;
+        }
+
+        // Снимок неизменяем, поэтому перевзвешивание делается один раз
+        if (negativeWeights)
+            negativeCycle = !johnsonPotentials(*this, potentials);
+    }
+
+    // -- Размеры и имена --
+    int vertexCount() const { return static_cast<int>(names.size()); }
+    int edgeCount() const { return static_cast<int>(outTargets.size()); }
+
+    int indexOf(const T& name) const
+    {
+        auto it = indices.find(name);
+        return it == indices.end() ? -1 : it->second;
+    }
+
+    const T& vertexName(int idx) const { return names[idx]; }
+
+    // -- Соседи: f(индекс соседа, вес) --
+    template<typename F>
+    void forEachOut(int u, F&& f) const
+    {
+        for (int k = outOffsets[u]; k < outOffsets[u + 1]; ++k)
+            f(outTargets[k], outWeights[k]);
+    }
+
+    template<typename F>
+    void forEachIn(int u, F&& f) const
+    {
+        for (int k = inOffsets[u]; k < inOffsets[u + 1]; ++k)
+            f(inSources[k], inWeights[k]);
+    }
+
+    bool hasSmallIntWeights() const { return smallIntWeights; }
+    bool hasNegativeWeights() const { return negativeWeights; }
+
+    int outDegree(int u) const { return outOffsets[u + 1] - outOffsets[u]; }
+    int inDegree(int u) const { return inOffsets[u + 1] - inOffsets[u]; }
+    int outTarget(int u, int k) const { return outTargets[outOffsets[u] + k]; }
+    int inSource(int u, int k) const { return inSources[inOffsets[u] + k]; }
+
+    // -- Алгоритмы (семантика как у Graph<T>) --
+    Path<T> dijkstraPath(const T& startName, const T& finishName,
+                         QueryWorkspace& ws = QueryWorkspace::local()) const;
+    Path<T> bidirectionalDijkstraPath(const T& startName, const T& finishName,
+                                      QueryWorkspace& forward = QueryWorkspace::local(0),
+                                      QueryWorkspace& backward = QueryWorkspace::local(1)) const;
+    std::vector<Path<T>> kShortestPaths(const T& startName, const T& finishName, int k,
+                                        QueryWorkspace& ws = QueryWorkspace::local()) const;
+    DistanceMatrix distanceMatrix(const std::vector<T>& sources, const std::vector<T>& targets,
+                                  int threadCount = defaultThreadCount()) const;
+    TraversalResult depthFirstSearch(const T& startName, TraversalOptions options = {},
+                                     QueryWorkspace& ws = QueryWorkspace::local()) const;
+    TraversalResult breadthFirstSearch(const T& startName, TraversalOptions options = {},
+                                       QueryWorkspace& ws = QueryWorkspace::local()) const;
+};
+
+// -----------------------------------------------------------------
+//  Алгоритм Дейкстры
+template<typename T>
+Path<T> CsrGraph<T>::dijkstraPath(const T& startName, const T& finishName,
+                                  QueryWorkspace& ws) const
+{
+    const int start = indexOf(startName);
+    const int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    if (negativeWeights)
+    {
+        requireNoNegativeCycle();
+        johnsonSearch(*this, potentials, start, finish, ws);
+    }
+    else
+    {
+        shortestPathSearch(*this, start, finish, ws);
+    }
+    return makePath<T>(*this, start, finish, ws);
+}
+
+// -----------------------------------------------------------------
+//  Двусторонняя Дейкстра
+template<typename T>
+Path<T> CsrGraph<T>::bidirectionalDijkstraPath(const T& startName, const T& finishName,
+                                              QueryWorkspace& forward,
+                                              QueryWorkspace& backward) const
+{
+    const int start = indexOf(startName);
+    const int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    // Правило остановки двусторонней Дейкстры при отрицательных весах
+    // не работает
+    if (negativeWeights)
+        return dijkstraPath(startName, finishName, forward);
+
+    int meet = bidirectionalShortestPathSearch(*this, start, finish, forward, backward);
+    return makeBidirectionalPath<T>(*this, meet, forward, backward);
+}
+
+// -----------------------------------------------------------------
+//  k кратчайших путей (Йен)
+template<typename T>
+std::vector<Path<T>> CsrGraph<T>::kShortestPaths(const T& startName, const T& finishName, int k,
+                                                  QueryWorkspace& ws) const
+{
+    std::vector<Path<T>> result;
+    const int start = indexOf(startName);
+    const int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return result;
+
+    std::vector<RankedRoute> routes;
+    if (negativeWeights)
+    {
+        requireNoNegativeCycle();
+        routes = yenKShortestPaths(ReweightedGraph<CsrGraph<T>>(*this, potentials),
+                                   start, finish, k, ws);
+    }
+    else
+    {
+        routes = yenKShortestPaths(*this, start, finish, k, ws);
+    }
+
+    result.reserve(routes.size());
+    for (const RankedRoute& r : routes)
+        result.push_back(makeRoutePath<T>(*this, r.vertices));
+    return result;
+}
+
+// -----------------------------------------------------------------
+//  Матрица расстояний
+template<typename T>
+DistanceMatrix CsrGraph<T>::distanceMatrix(const std::vector<T>& sources,
+                                           const std::vector<T>& targets,
+                                           int threadCount) const
+{
+    std::vector<int> from;
+    std::vector<int> to;
+    from.reserve(sources.size());
+    to.reserve(targets.size());
+    for (const T& name : sources)
+        from.push_back(indexOf(name));
+    for (const T& name : targets)
+        to.push_back(indexOf(name));
+
+    if (negativeWeights)
+    {
+        requireNoNegativeCycle();
+        return johnsonDistanceMatrix(*this, potentials, from, to, threadCount);
+    }
+    return dijkstraDistanceMatrix(*this, from, to, threadCount);
+}
+
+// -----------------------------------------------------------------
+//  DFS / BFS (Traversal.h): тот же TraversalResult по индексам, что
+//  и у Graph<T>; имена — vertexName или printTraversal
+template<typename T>
+TraversalResult CsrGraph<T>::depthFirstSearch(const T& startName, TraversalOptions options,
+                                              QueryWorkspace& ws) const
+{
+    return depthFirstTraversal(*this, indexOf(startName), options, ws);
+}
+
+template<typename T>
+TraversalResult CsrGraph<T>::breadthFirstSearch(const T& startName, TraversalOptions options,
+                                                QueryWorkspace& ws) const
+{
+    return breadthFirstTraversal(*this, indexOf(startName), options, ws);
+}
+
+#endif // CSR_GRAPH_H
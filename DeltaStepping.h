@@ -0,0 +1,240 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "DynamicArray.h"
+#include "Parallel.h"
+
+// Параллельный delta-stepping (Meyer, Sanders) — кратчайшие расстояния
+// от одной вершины до всех.
+// Вершины лежат в корзинах шириной delta по текущему расстоянию.
+// Корзина обрабатывается фазами: все её вершины параллельно
+// релаксируют «лёгкие» рёбра (вес <= delta), которые могут вернуть
+// вершину в ту же корзину, пока корзина не опустеет. Затем один раз
+// релаксируются «тяжёлые» рёбра всех вершин, прошедших через корзину.
+// Рёбра делятся на лёгкие и тяжёлые один раз, при построении; сам
+// граф после этого не нужен, решатель хранит только свои массивы.
+
+template<typename T>
+class DeltaStepping
+{
+private:
+    // Больше корзин не бывает: delta не меньше суммы весов / MAX_BUCKETS,
+    // так что номер корзины всегда помещается в long long
+    static constexpr double MAX_BUCKETS = 1 << 24;
+
+    int vertexCount = 0;
+    double delta = 1.0;
+
+    // CSR лёгких и тяжёлых рёбер
+    std::vector<int> lightOffsets;
+    std::vector<int> lightTargets;
+    std::vector<double> lightWeights;
+    std::vector<int> heavyOffsets;
+    std::vector<int> heavyTargets;
+    std::vector<double> heavyWeights;
+
+    static void relax(std::atomic<double>& dist, double candidate, bool& improved)
+    {
+        double current = dist.load(std::memory_order_relaxed);
+        while (candidate < current)
+        {
+            if (dist.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                improved = true;
+                return;
+            }
+        }
+    }
+
+public:
+    // delta <= 0 — взять средний вес ребра. Слишком узкие корзины
+    // расширяются (см. MAX_BUCKETS); итог — bucketWidth()
+    explicit DeltaStepping(const CsrGraph<T>& graph, double bucketWidth = 0.0)
+        : vertexCount(graph.vertexCount())
+    {
+        const int n = vertexCount;
+        double total = 0.0;
+        for (int u = 0; u < n; ++u)
+        {
+            graph.forEachOut(u, [&](int, double w){
+                if (w < 0.0)
+                    throw std::runtime_error("Delta-stepping не поддерживает отрицательные веса.");
+                if (!std::isfinite(w))
+                    throw std::runtime_error("Delta-stepping: вес ребра должен быть конечным.");
+                total += w;
+            });
+        }
+        if (bucketWidth > 0.0)
+            delta = bucketWidth;
+        else if (graph.edgeCount() > 0 && total > 0.0)
+            delta = total / graph.edgeCount();
+        delta = std::max(delta, total / MAX_BUCKETS);
+
+        lightOffsets.assign(n + 1, 0);
+        heavyOffsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u)
+        {
+            lightOffsets[u + 1] = lightOffsets[u];
+            heavyOffsets[u + 1] = heavyOffsets[u];
+            graph.forEachOut(u, [&](int v, double w){
+                if (w <= delta)
+                {
+                    lightTargets.push_back(v);
+                    lightWeights.push_back(w);
+                    ++lightOffsets[u + 1];
+                }
+                else
+                {
+                    heavyTargets.push_back(v);
+                    heavyWeights.push_back(w);
+                    ++heavyOffsets[u + 1];
+                }
+            });
+        }
+    }
+
+    double bucketWidth() const { return delta; }
+    int edgeCount() const { return static_cast<int>(lightTargets.size() + heavyTargets.size()); }
+
+    // Точные расстояния от source (бесконечность — недостижима;
+    // source вне графа — все бесконечны)
+    std::vector<double> run(int source, ThreadPool& pool) const
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const int n = vertexCount;
+        const int threads = pool.size();
+
+        std::vector<double> result(n, INF);
+        if (source < 0 || source >= n)
+            return result;
+
+        std::vector<std::atomic<double>> dist(n);
+        for (auto& d : dist)
+            d.store(INF, std::memory_order_relaxed);
+
+        std::vector<std::vector<int>> buckets;
+        std::vector<long long> bucketOf(n, -1);  // корзина, где вершина лежит сейчас
+        std::vector<char> settledHere(n, 0);     // прошла через текущую корзину
+        std::vector<std::vector<int>> improved(threads);
+
+        auto bucketIndex = [&](double d) {
+            return static_cast<long long>(std::floor(d / delta));
+        };
+        auto place = [&](int v) {
+            long long b = bucketIndex(dist[v].load(std::memory_order_relaxed));
+            if (bucketOf[v] == b)
+                return;
+            if (b >= static_cast<long long>(buckets.size()))
+                buckets.resize(b + 1);
+            buckets[b].push_back(v);
+            bucketOf[v] = b;
+        };
+
+        // Параллельная релаксация рёбер frontier из выбранного CSR
+        auto relaxAll = [&](const std::vector<int>& frontier,
+                            const std::vector<int>& offsets,
+                            const std::vector<int>& targets,
+                            const std::vector<double>& weights) {
+            std::atomic<std::size_t> next{0};
+            pool.run([&](int tid) {
+                const std::size_t chunk = 64;
+                auto& out = improved[tid];
+                for (std::size_t begin = next.fetch_add(chunk); begin < frontier.size();
+                     begin = next.fetch_add(chunk))
+                {
+                    std::size_t end = std::min(begin + chunk, frontier.size());
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        int u = frontier[i];
+                        double du = dist[u].load(std::memory_order_relaxed);
+                        for (int k = offsets[u]; k < offsets[u + 1]; ++k)
+                        {
+                            bool changed = false;
+                            relax(dist[targets[k]], du + weights[k], changed);
+                            if (changed)
+                                out.push_back(targets[k]);
+                        }
+                    }
+                }
+            });
+            // Раскладываем улучшенные вершины по корзинам (последовательно)
+            for (auto& list : improved)
+            {
+                for (int v : list)
+                    place(v);
+                list.clear();
+            }
+        };
+
+        dist[source].store(0.0, std::memory_order_relaxed);
+        place(source);
+
+        std::vector<int> frontier;
+        std::vector<int> settled;
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+        {
+            settled.clear();
+            while (!buckets[i].empty())
+            {
+                // Забираем корзину; устаревшие записи (вершина ушла
+                // в корзину пониже) отбрасываем
+                frontier.clear();
+                for (int v : buckets[i])
+                {
+                    if (bucketOf[v] != static_cast<long long>(i))
+                        continue;
+                    bucketOf[v] = -1;
+                    frontier.push_back(v);
+                    if (!settledHere[v])
+                    {
+                        settledHere[v] = 1;
+                        settled.push_back(v);
+                    }
+                }
+                buckets[i].clear();
+                relaxAll(frontier, lightOffsets, lightTargets, lightWeights);
+            }
+            relaxAll(settled, heavyOffsets, heavyTargets, heavyWeights);
+            for (int v : settled)
+                settledHere[v] = 0;
+        }
+
+        for (int v = 0; v < n; ++v)
+            result[v] = dist[v].load(std::memory_order_relaxed);
+        return result;
+    }
+
+    // Расстояния в формате Path<T>::GetDistances(): по порядку вершин,
+    // усечённые до int, -1 — недостижима (или нет такой вершины).
+    // graph — тот же снимок, по которому построен решатель
+    DynamicArray<int> distances(const CsrGraph<T>& graph, const T& sourceName, ThreadPool& pool) const
+    {
+        if (graph.vertexCount() != vertexCount || graph.edgeCount() != edgeCount())
+            throw std::runtime_error("Delta-stepping построен для другого графа.");
+
+        const int n = vertexCount;
+        const int source = graph.indexOf(sourceName);
+
+        DynamicArray<int> distArr;
+        if (source < 0)
+        {
+            for (int i = 0; i < n; ++i)
+                distArr.push_back(-1);
+            return distArr;
+        }
+
+        std::vector<double> dist = run(source, pool);
+        for (double d : dist)
+            distArr.push_back(d == std::numeric_limits<double>::infinity() ? -1 : static_cast<int>(d));
+        return distArr;
+    }
+};
+
+#endif // DELTA_STEPPING_H
@@ -0,0 +1,149 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include "Path.h"
+#include "DynamicArray.h"
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+
+// Движок Дейкстры на плотных индексах вершин.
+// G — любой граф с методами vertexCount(), vertexName(i)
+// и forEachOut(u, f(v, weight)): Graph<T> или CsrGraph<T>.
+// Имена вершин (T) в самом поиске не участвуют: куча хранит пары
+// (расстояние, индекс), dist/prev — плоские массивы из QueryWorkspace.
+
+// Очередь по умолчанию выбирается при сборке:
+// -DLAB4_INDEXED_HEAP=ON в CMake включает индексированную 4-арную кучу.
+#ifdef LAB4_INDEXED_HEAP
+using DefaultDijkstraHeap = IndexedHeap<4>;
+#else
+using DefaultDijkstraHeap = LazyHeap;
+#endif
+
+// Поиск из start; stop(v) вызывается для каждой вершины в момент
+// извлечения из кучи (её расстояние уже окончательное), true — закончить.
+// Метки dist/prev остаются в ws до следующего reset().
+// Heap — очередь из PriorityQueues.h (LazyHeap, IndexedHeap<D>, ...).
+template<typename Heap = DefaultDijkstraHeap, typename G, typename Stop>
+void dijkstraSearchUntil(const G& graph, int start, Stop&& stop, QueryWorkspace& ws,
+                         Heap& heap = localQueue<Heap>())
+{
+    ws.reset(graph.vertexCount());
+    heap.clear();
+
+    ws.setLabel(start, 0.0, -1);
+    heap.push(start, 0.0);
+
+    while (!heap.empty())
+    {
+        auto [curDist, cur] = heap.pop();
+
+        // Устаревшая запись (бывает только у ленивой кучи)
+        if (curDist > ws.distance(cur))
+            continue;
+        if (stop(cur))
+            break;
+
+        graph.forEachOut(cur, [&](int neigh, double weight){
+            double alt = curDist + weight;
+            if (alt < ws.distance(neigh))
+            {
+                ws.setLabel(neigh, alt, cur);
+                heap.push(neigh, alt);
+            }
+        });
+    }
+}
+
+// Поиск из start; если finish >= 0, останавливаемся, как только финиш
+// извлечён из кучи
+template<typename Heap = DefaultDijkstraHeap, typename G>
+void dijkstraSearch(const G& graph, int start, int finish, QueryWorkspace& ws,
+                    Heap& heap = localQueue<Heap>())
+{
+    dijkstraSearchUntil(graph, start, [finish](int v){ return v == finish; }, ws, heap);
+}
+
+// Дейкстра с выбором очереди по весам графа: если все веса — небольшие
+// целые (graph.hasSmallIntWeights()), работают корзины Дайала с O(1)
+// на релаксацию, иначе — куча по умолчанию
+template<typename G>
+void shortestPathSearch(const G& graph, int start, int finish, QueryWorkspace& ws)
+{
+    if (graph.hasSmallIntWeights())
+        dijkstraSearch<BucketQueue>(graph, start, finish, ws);
+    else
+        dijkstraSearch(graph, start, finish, ws);
+}
+
+// Граф с развёрнутыми рёбрами: поиск по нему из v даёт расстояния до v
+template<typename G>
+class ReversedGraph
+{
+private:
+    const G& graph;
+
+public:
+    explicit ReversedGraph(const G& g)
+        : graph(g)
+    {
+    }
+
+    int vertexCount() const { return graph.vertexCount(); }
+    decltype(auto) vertexName(int idx) const { return graph.vertexName(idx); }
+    bool hasSmallIntWeights() const { return graph.hasSmallIntWeights(); }
+
+    template<typename F>
+    void forEachOut(int u, F&& f) const { graph.forEachIn(u, std::forward<F>(f)); }
+
+    template<typename F>
+    void forEachIn(int u, F&& f) const { graph.forEachOut(u, std::forward<F>(f)); }
+};
+
+// Результат «нет такой вершины»: -1 на каждую вершину, пустой путь
+template<typename T>
+Path<T> makeMissingPath(int vertexCount)
+{
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+    for (int i = 0; i < vertexCount; ++i)
+        distArr.push_back(-1);
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+// Упаковка dist/prev в Path<T>: расстояния по порядку вершин
+// (-1 — недостижима, иначе усечённое до int), путь start -> finish
+template<typename T, typename G>
+Path<T> makePath(const G& graph, int start, int finish, const QueryWorkspace& ws)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+
+    const int n = graph.vertexCount();
+    for (int i = 0; i < n; ++i)
+    {
+        double d = ws.distance(i);
+        distArr.push_back(d == INF ? -1 : static_cast<int>(d));
+    }
+
+    if (ws.distance(finish) == INF)
+        return Path<T>(std::move(distArr), std::move(pathArr));
+
+    // Считаем длину пути, чтобы сразу писать вершины на свои места
+    int length = 1;
+    for (int v = finish; v != start; v = ws.parent(v))
+        ++length;
+
+    pathArr = DynamicArray<T>(static_cast<std::size_t>(length));
+    int pos = length - 1;
+    for (int v = finish; pos >= 0; v = ws.parent(v))
+        pathArr[pos--] = graph.vertexName(v);
+
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+#endif // DIJKSTRA_H
@@ -0,0 +1,141 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <stdexcept>
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+#include "Parallel.h"
+#include "NegativeWeights.h"
+
+// Матрица расстояний «многие ко многим»: строка i — расстояния от
+// sources[i] до всех targets, хранится подряд (row-major) в одном массиве.
+// Бесконечность — цель недостижима (или такой вершины нет).
+
+class DistanceMatrix
+{
+private:
+    int rowCount = 0;
+    int columnCount = 0;
+    std::vector<double> values;
+
+public:
+    DistanceMatrix() = default;
+
+    DistanceMatrix(int rows, int columns)
+        : rowCount(rows), columnCount(columns),
+          values(static_cast<std::size_t>(rows) * columns,
+                 std::numeric_limits<double>::infinity())
+    {
+    }
+
+    int rows() const { return rowCount; }
+    int columns() const { return columnCount; }
+
+    double at(int row, int column) const
+    {
+        return values[static_cast<std::size_t>(row) * columnCount + column];
+    }
+
+    double* row(int r) { return values.data() + static_cast<std::size_t>(r) * columnCount; }
+    const double* row(int r) const { return values.data() + static_cast<std::size_t>(r) * columnCount; }
+
+    const std::vector<double>& data() const { return values; }
+};
+
+// Один поиск Дейкстры на источник; поиск останавливается, как только
+// извлечены все (различные) цели. Строки считаются параллельно,
+// у каждого потока свои QueryWorkspace::local() и очередь.
+// Индекс -1 в sources/targets — «нет такой вершины»: строка/столбец INF.
+// Только для неотрицательных весов; общий случай — distanceMatrix ниже.
+template<typename G>
+DistanceMatrix dijkstraDistanceMatrix(const G& graph, const std::vector<int>& sources,
+                                      const std::vector<int>& targets,
+                                      int threadCount = defaultThreadCount())
+{
+    const int rows = static_cast<int>(sources.size());
+    const int columns = static_cast<int>(targets.size());
+    DistanceMatrix matrix(rows, columns);
+
+    // Цели как множество: флаг на вершину + число различных целей
+    std::vector<char> isTarget(graph.vertexCount(), 0);
+    int distinctTargets = 0;
+    for (int t : targets)
+    {
+        if (t >= 0 && !isTarget[t])
+        {
+            isTarget[t] = 1;
+            ++distinctTargets;
+        }
+    }
+
+    const bool buckets = graph.hasSmallIntWeights();
+    parallelFor(rows, threadCount, [&](int r){
+        const int source = sources[r];
+        if (source < 0 || distinctTargets == 0)
+            return;
+
+        QueryWorkspace& ws = QueryWorkspace::local();
+        int remaining = distinctTargets;
+        auto allSettled = [&](int v) {
+            return isTarget[v] && --remaining == 0;
+        };
+        if (buckets)
+            dijkstraSearchUntil<BucketQueue>(graph, source, allSettled, ws);
+        else
+            dijkstraSearchUntil(graph, source, allSettled, ws);
+
+        double* out = matrix.row(r);
+        for (int c = 0; c < columns; ++c)
+        {
+            if (targets[c] >= 0)
+                out[c] = ws.distance(targets[c]);
+        }
+    });
+    return matrix;
+}
+
+// Матрица по перевзвешенному графу (потенциалы Джонсона) с обратным
+// переводом в настоящие расстояния
+template<typename G>
+DistanceMatrix johnsonDistanceMatrix(const G& graph, const std::vector<double>& potentials,
+                                     const std::vector<int>& sources,
+                                     const std::vector<int>& targets, int threadCount)
+{
+    DistanceMatrix matrix = dijkstraDistanceMatrix(ReweightedGraph<G>(graph, potentials),
+                                                   sources, targets, threadCount);
+    for (int r = 0; r < matrix.rows(); ++r)
+    {
+        if (sources[r] < 0)
+            continue;
+        double* row = matrix.row(r);
+        for (int c = 0; c < matrix.columns(); ++c)
+        {
+            if (targets[c] >= 0)
+                row[c] += potentials[targets[c]] - potentials[sources[r]];
+        }
+    }
+    return matrix;
+}
+
+// G — Graph<T> или CsrGraph<T>. При отрицательных весах потенциалы
+// считаются на месте (CsrGraph<T>::distanceMatrix берёт готовые из
+// снимка), отрицательный цикл — исключение
+template<typename G>
+DistanceMatrix distanceMatrix(const G& graph, const std::vector<int>& sources,
+                              const std::vector<int>& targets,
+                              int threadCount = defaultThreadCount())
+{
+    if (!graph.hasNegativeWeights())
+        return dijkstraDistanceMatrix(graph, sources, targets, threadCount);
+
+    std::vector<double> potentials;
+    if (!johnsonPotentials(graph, potentials))
+        throw std::runtime_error("В графе есть цикл отрицательного веса.");
+    return johnsonDistanceMatrix(graph, potentials, sources, targets, threadCount);
+}
+
+#endif // DISTANCE_MATRIX_H
@@ -38,6 +38,10 @@ class DynamicArray
 
         size_t get_size() const noexcept;
 
+        // Непрерывный буфер элементов (например, для std::span)
+        T *get_data() noexcept;
+        const T *get_data() const noexcept;
+
         T &operator[](const size_t index);
         T operator[](const size_t index) const;
     DynamicArray &operator=(const DynamicArray<T> &other);
@@ -56,7 +60,7 @@ template <typename T> DynamicArray<T>::DynamicArray()
     capacity = 1;
 }
 
-template <typename T> DynamicArray<T>::DynamicArray(const size_t capacity) : capacity(capacity), size(capacity)
+template <typename T> DynamicArray<T>::DynamicArray(const size_t capacity) : size(capacity), capacity(capacity)
 {
     data = new T[capacity];
 }
@@ -96,14 +100,14 @@ template <typename T> DynamicArray<T>::~DynamicArray() noexcept
 template <typename T> void DynamicArray<T>::push_back(const T &value)
 {
     if (size == capacity)
-        resize(capacity * 2);
+        resize(capacity == 0 ? 1 : capacity * 2);
     data[size++] = value;
 }
 
 template <typename T> void DynamicArray<T>::push_front(const T &value)
 {
     if (size == capacity)
-        resize(capacity * 2);
+        resize(capacity == 0 ? 1 : capacity * 2);
     std::copy_backward(data, data + size, data + size + 1);
     data[0] = value;
 }
@@ -125,7 +129,7 @@ template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::insert
         throw std::invalid_argument("Invalid position");
     size_t pos_index = position - begin();
     if (size == capacity)
-        resize(capacity * 2);
+        resize(capacity == 0 ? 1 : capacity * 2);
     std::copy_backward(data + pos_index, data + size, data + size + 1);
     DynamicArray<T>::iterator new_pos = iterator(data + pos_index);
     *new_pos = value;
@@ -140,7 +144,7 @@ template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::insert
     size_t dist = last - first;
     size_t pos_index = position - begin();
     while (capacity - size < dist)
-        resize(capacity * 2);
+        resize(capacity == 0 ? 1 : capacity * 2);
     std::copy_backward(data + pos_index, data + size, data + size + dist);
     std::copy(first, last, data + pos_index);
     size += dist;
@@ -187,6 +191,16 @@ template <typename T> size_t DynamicArray<T>::get_size() const noexcept
     return size;
 }
 
+template <typename T> T *DynamicArray<T>::get_data() noexcept
+{
+    return data;
+}
+
+template <typename T> const T *DynamicArray<T>::get_data() const noexcept
+{
+    return data;
+}
+
 template <typename T> T &DynamicArray<T>::operator[](const size_t index)
 {
     if (index >= size)
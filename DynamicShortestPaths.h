@@ -0,0 +1,237 @@
+#ifndef DYNAMIC_SHORTEST_PATHS_H
+#define DYNAMIC_SHORTEST_PATHS_H
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include "Graph.h"
+#include "Path.h"
+#include "ShortestPathTree.h"
+#include "PriorityQueues.h"
+#include "QueryWorkspace.h"
+
+// Дерево кратчайших путей от одной вершины, которое поддерживается при
+// правках рёбер (в духе Ramalingam — Reps) вместо полного пересчёта.
+// Правки идут через этот класс: он меняет Graph<T> и чинит дерево.
+//  - Ребро стало короче (добавлено / вес уменьшен): Дейкстра стартует
+//    только из его конца и идёт, пока метки улучшаются.
+//  - Ребро дерева удалено / стало длиннее: метки теряет лишь поддерево
+//    его конца. Для этих вершин берётся лучший вход из остальной части
+//    дерева, и Дейкстра расходится только по поддереву.
+// Если граф правили в обход класса (версия не совпала), дерево
+// пересчитывается целиком при следующем обращении.
+// Веса должны быть неотрицательными.
+
+template<typename T>
+class DynamicShortestPaths
+{
+private:
+    using Heap = DefaultDijkstraHeap;
+
+    Graph<T>& graph;
+    T sourceName;
+    ShortestPathTree<T> tree;   // версия дерева — версия графа после последней починки
+    std::vector<char> affected;  // рабочая метка поддерева, между правками — нули
+    std::vector<int> subtree;    // вершины поддерева при починке (буфер переиспользуется)
+
+    static void requireNonNegative(double weight)
+    {
+        if (weight < 0.0)
+            throw std::runtime_error("Динамические кратчайшие пути не поддерживают отрицательные веса.");
+    }
+
+    void recompute()
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const int n = graph.vertexCount();
+        tree = ShortestPathTree<T>(graph, -1, std::vector<double>(n, INF), std::vector<int>(n, -1));
+        affected.assign(n, 0);
+
+        const int source = graph.indexOf(sourceName);
+        if (source < 0)
+            return;
+        tree.sourceIndex = source;
+        if (graph.hasNegativeWeights())
+            throw std::runtime_error("Динамические кратчайшие пути не поддерживают отрицательные веса.");
+
+        QueryWorkspace& ws = QueryWorkspace::local();
+        shortestPathSearch(graph, source, -1, ws);
+        for (int v = 0; v < n; ++v)
+        {
+            tree.dist[v] = ws.distance(v);
+            tree.prev[v] = ws.parent(v);
+        }
+    }
+
+    void sync()
+    {
+        if (graph.version() != tree.version)
+            recompute();
+    }
+
+    // Дейкстра по меткам дерева от вершин, уже лежащих в куче
+    void propagate(Heap& heap)
+    {
+        while (!heap.empty())
+        {
+            auto [curDist, cur] = heap.pop();
+            if (curDist > tree.dist[cur])
+                continue;
+            graph.forEachOut(cur, [&](int neigh, double weight){
+                double alt = curDist + weight;
+                if (alt < tree.dist[neigh])
+                {
+                    tree.dist[neigh] = alt;
+                    tree.prev[neigh] = cur;
+                    heap.push(neigh, alt);
+                }
+            });
+        }
+    }
+
+    // Ребро u -> v веса w появилось или стало легче
+    void repairDecrease(int u, int v, double weight)
+    {
+        double alt = tree.dist[u] + weight;
+        if (!(alt < tree.dist[v]))
+            return;
+        Heap& heap = localQueue<Heap>();
+        heap.clear();
+        tree.dist[v] = alt;
+        tree.prev[v] = u;
+        heap.push(v, alt);
+        propagate(heap);
+    }
+
+    // Вершина v потеряла ребро дерева, ведущее в неё
+    void repairIncrease(int v)
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+
+        // Поддерево v: дети x — соседи, у которых prev == x
+        subtree.clear();
+        subtree.push_back(v);
+        affected[v] = 1;
+        for (std::size_t i = 0; i < subtree.size(); ++i)
+        {
+            int x = subtree[i];
+            graph.forEachOut(x, [&](int y, double){
+                if (tree.prev[y] == x && !affected[y])
+                {
+                    affected[y] = 1;
+                    subtree.push_back(y);
+                }
+            });
+        }
+        for (int x : subtree)
+        {
+            tree.dist[x] = INF;
+            tree.prev[x] = -1;
+        }
+
+        // Лучший вход в каждую вершину поддерева из его внешней части
+        Heap& heap = localQueue<Heap>();
+        heap.clear();
+        for (int x : subtree)
+        {
+            graph.forEachIn(x, [&](int y, double weight){
+                if (affected[y])
+                    return;
+                double alt = tree.dist[y] + weight;
+                if (alt < tree.dist[x])
+                {
+                    tree.dist[x] = alt;
+                    tree.prev[x] = y;
+                }
+            });
+            if (tree.dist[x] != INF)
+                heap.push(x, tree.dist[x]);
+        }
+        for (int x : subtree)
+            affected[x] = 0;
+        propagate(heap);
+    }
+
+    std::pair<int, int> endpoints(const T& startName, const T& finishName) const
+    {
+        int u = graph.indexOf(startName);
+        int v = graph.indexOf(finishName);
+        if (u < 0 || v < 0)
+            throw std::runtime_error("Не найдена вершина при изменении ребра.");
+        return {u, v};
+    }
+
+public:
+    DynamicShortestPaths(Graph<T>& g, const T& sourceVertex)
+        : graph(g), sourceName(sourceVertex)
+    {
+        recompute();
+    }
+
+    // -- Правки графа с починкой дерева --
+    void addEdge(const T& startName, const T& finishName, double weight)
+    {
+        requireNonNegative(weight);
+        sync();
+        auto [u, v] = endpoints(startName, finishName);
+        graph.addEdge(startName, finishName, weight);
+        tree.version = graph.version();
+        repairDecrease(u, v, weight);
+    }
+
+    void removeEdge(const T& startName, const T& finishName)
+    {
+        sync();
+        int u = graph.indexOf(startName);
+        int v = graph.indexOf(finishName);
+        graph.removeEdge(startName, finishName);
+        tree.version = graph.version();
+        if (u >= 0 && v >= 0 && tree.prev[v] == u)
+            repairIncrease(v);
+    }
+
+    // Новый вес ребра u -> v (параллельные рёбра u -> v заменяются одним)
+    void setEdgeWeight(const T& startName, const T& finishName, double weight)
+    {
+        requireNonNegative(weight);
+        sync();
+        auto [u, v] = endpoints(startName, finishName);
+        const bool treeEdge = tree.prev[v] == u;
+        graph.removeEdge(startName, finishName);
+        graph.addEdge(startName, finishName, weight);
+        tree.version = graph.version();
+        if (treeEdge)
+            repairIncrease(v);
+        repairDecrease(u, v, weight);
+    }
+
+    // -- Запросы --
+    // Бесконечность — недостижима (или вершины нет)
+    double distance(const T& name)
+    {
+        sync();
+        int v = graph.indexOf(name);
+        return v < 0 ? std::numeric_limits<double>::infinity() : tree.dist[v];
+    }
+
+    // Тот же формат, что у Graph<T>::dijkstraPath (расстояния точные
+    // для всех вершин)
+    Path<T> path(const T& finishName)
+    {
+        sync();
+        int finish = graph.indexOf(finishName);
+        if (tree.source() < 0 || finish < 0)
+            return makeMissingPath<T>(graph.vertexCount());
+        return makeTreePath<T>(graph, finish, tree);
+    }
+
+    // Текущее дерево (после починки или пересчёта)
+    const ShortestPathTree<T>& shortestPathTree()
+    {
+        sync();
+        return tree;
+    }
+};
+
+#endif // DYNAMIC_SHORTEST_PATHS_H
@@ -1,23 +1,21 @@
 #ifndef EDGE_H
 #define EDGE_H
 
-#include "Vertex.h"
+// Ребро хранит не копии вершин, а их индексы (handle) в Graph<T>::vertices.
+// Так ребро занимает 16 байт, а добавление ребра — O(1).
 
-// По «скриншоту» Edge хранит два объекта Vertex<T> (start, finish).
-
-template <typename T>
 struct Edge
 {
-    Vertex<T> start;
-    Vertex<T> finish;
+    int start;     // индекс начальной вершины
+    int finish;    // индекс конечной вершины
     double weight;
 
     Edge()
-        : weight(0.0)
+        : start(-1), finish(-1), weight(0.0)
     {
     }
 
-    Edge(const Vertex<T>& s, const Vertex<T>& f, double w)
+    Edge(int s, int f, double w)
         : start(s), finish(f), weight(w)
     {
     }
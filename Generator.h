@@ -0,0 +1,131 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <ranges>
+#include <utility>
+#include <iterator>
+#include <coroutine>
+#include <exception>
+
+// Ленивая последовательность на корутине: минимальная замена
+// std::generator (C++23), которого нет в libstdc++ 12.
+// Тело корутины выполняется только по мере продвижения итератора
+// (co_yield отдаёт очередной элемент и приостанавливает её).
+// Разрушение генератора уничтожает кадр корутины со всем её
+// состоянием, так что брошенный на середине обход больше не работает.
+// Генератор — input_range и view: его можно передавать в ranges-конвейеры
+// по значению (gen | std::views::take(5)). Обойти можно один раз.
+
+template<typename T>
+class Generator : public std::ranges::view_interface<Generator<T>>
+{
+public:
+    struct promise_type
+    {
+        T current{};
+        std::exception_ptr error;
+
+        Generator get_return_object()
+        {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(T value) noexcept
+        {
+            current = std::move(value);
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+
+        // co_await внутри генератора не нужен
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+    private:
+        Handle coroutine;
+
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(Handle h) : coroutine(h) {}
+
+        const T& operator*() const { return coroutine.promise().current; }
+
+        iterator& operator++()
+        {
+            advance(coroutine);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t)
+        {
+            return !it.coroutine || it.coroutine.done();
+        }
+    };
+
+private:
+    Handle coroutine;
+
+    explicit Generator(Handle h) : coroutine(h) {}
+
+    static void advance(Handle h)
+    {
+        h.resume();
+        if (h.promise().error)
+            std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+    }
+
+public:
+    Generator() = default;
+
+    Generator(Generator&& other) noexcept
+        : coroutine(std::exchange(other.coroutine, nullptr))
+    {
+    }
+
+    Generator& operator=(Generator&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (coroutine)
+                coroutine.destroy();
+            coroutine = std::exchange(other.coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator()
+    {
+        if (coroutine)
+            coroutine.destroy();
+    }
+
+    // Запускает корутину до первого co_yield
+    iterator begin()
+    {
+        if (coroutine && !coroutine.done())
+            advance(coroutine);
+        return iterator(coroutine);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+#endif // GENERATOR_H
@@ -1,33 +1,77 @@
 #include "Graph.h"
 #include <stdexcept>
 #include <iostream>
-#include <queue>
-#include <limits>
 #include <algorithm>
-#include <unordered_map>
+#include <limits>
+#include <cmath>
 
 // -----------------------------------------------------------------
 //  Вспомогательные методы
+template<typename T>
+int Graph<T>::indexOf(const T& name) const
+{
+    auto it = indices.find(name);
+    return it == indices.end() ? -1 : it->second;
+}
+
 template<typename T>
 Vertex<T>* Graph<T>::findVertex(const T& name)
 {
-    for (auto& v : vertices)
-    {
-        if (v.name == name)
-            return &v;
-    }
-    return nullptr;
+    int idx = indexOf(name);
+    return idx < 0 ? nullptr : &vertices[idx];
 }
 
 template<typename T>
 const Vertex<T>* Graph<T>::findVertexConst(const T& name) const
 {
-    for (auto& v : vertices)
+    int idx = indexOf(name);
+    return idx < 0 ? nullptr : &vertices[idx];
+}
+
+// Снять удаляемое ребро со счётчиков по весам
+template<typename T>
+void Graph<T>::uncountEdge(const Edge& e)
+{
+    if (!BucketQueue::accepts(e.weight))
+        --nonSmallWeightEdges;
+    if (e.weight < 0.0)
+        --negativeWeightEdges;
+}
+
+// Удаление рёбер из общего списка edges с учётом счётчиков по весам
+template<typename T>
+template<typename Pred>
+void Graph<T>::eraseEdges(Pred pred)
+{
+    refreshEdges();
+    for (const Edge& e : edges)
     {
-        if (v.name == name)
-            return &v;
+        if (pred(e))
+            uncountEdge(e);
     }
-    return nullptr;
+    potentialsDirty = true;
+    edges.erase(std::remove_if(edges.begin(), edges.end(), pred), edges.end());
+}
+
+// Общий список рёбер ведётся лениво: removeEdge правит только out/in
+// своих концов (O(степени), а не O(E)), а edges собирается заново из
+// out-списков, когда он действительно нужен (freeze, A*, removeVertex)
+template<typename T>
+std::vector<Edge> Graph<T>::collectEdges() const
+{
+    std::vector<Edge> result;
+    for (const auto& vx : vertices)
+        result.insert(result.end(), vx.out.begin(), vx.out.end());
+    return result;
+}
+
+template<typename T>
+void Graph<T>::refreshEdges()
+{
+    if (!edgesStale)
+        return;
+    edges = collectEdges();
+    edgesStale = false;
 }
 
 // -----------------------------------------------------------------
@@ -40,44 +84,56 @@ void Graph<T>::addVertex(const T& name)
         std::cerr << "Вершина '" << name << "' уже существует!\n";
         return;
     }
+    indices.emplace(name, static_cast<int>(vertices.size()));
     vertices.emplace_back(name);
+    ++unplacedVertices;
+    potentialsDirty = true;
+    graphVersion = nextGraphVersion();
 }
 
 template<typename T>
 void Graph<T>::removeVertex(const T& name)
 {
-    Vertex<T>* vPtr = findVertex(name);
-    if (!vPtr)
+    int idx = indexOf(name);
+    if (idx < 0)
     {
         std::cerr << "Вершина '" << name << "' не найдена. Удалять нечего.\n";
         return;
     }
 
+    auto touches = [idx](const Edge& e){
+        return (e.start == idx || e.finish == idx);
+    };
+    // После удаления вершины индексы всех следующих за ней сдвигаются на 1
+    auto shift = [idx](Edge& e){
+        if (e.start > idx)
+            --e.start;
+        if (e.finish > idx)
+            --e.finish;
+    };
+
     // Удаляем рёбра из общего списка edges
-    edges.erase(std::remove_if(edges.begin(), edges.end(),
-        [&](const Edge<T>& e){
-            return (e.start.name == name || e.finish.name == name);
-        }), edges.end());
+    eraseEdges(touches);
+    std::for_each(edges.begin(), edges.end(), shift);
 
     // Удаляем эти же рёбра из in/out остальных вершин
     for (auto& vx : vertices)
     {
-        vx.out.erase(std::remove_if(vx.out.begin(), vx.out.end(),
-            [&](const Edge<T>& e){
-                return (e.start.name == name || e.finish.name == name);
-            }), vx.out.end());
-
-        vx.in.erase(std::remove_if(vx.in.begin(), vx.in.end(),
-            [&](const Edge<T>& e){
-                return (e.start.name == name || e.finish.name == name);
-            }), vx.in.end());
+        vx.out.erase(std::remove_if(vx.out.begin(), vx.out.end(), touches), vx.out.end());
+        vx.in.erase(std::remove_if(vx.in.begin(), vx.in.end(), touches), vx.in.end());
+        std::for_each(vx.out.begin(), vx.out.end(), shift);
+        std::for_each(vx.in.begin(), vx.in.end(), shift);
     }
 
-    // Удаляем саму вершину
-    vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
-        [&](const Vertex<T>& vx){
-            return vx.name == name;
-        }), vertices.end());
+    // Удаляем саму вершину и сдвигаем индексы следующих за ней
+    if (!vertices[idx].placed)
+        --unplacedVertices;
+    heuristicScaleDirty = true;
+    graphVersion = nextGraphVersion();
+    indices.erase(name);
+    vertices.erase(vertices.begin() + idx);
+    for (int i = idx; i < static_cast<int>(vertices.size()); ++i)
+        indices[vertices[i].name] = i;
 }
 
 // -----------------------------------------------------------------
@@ -85,47 +141,132 @@ void Graph<T>::removeVertex(const T& name)
 template<typename T>
 void Graph<T>::addEdge(const T& startName, const T& finishName, double weight)
 {
-    Vertex<T>* s = findVertex(startName);
-    Vertex<T>* f = findVertex(finishName);
-    if (!s || !f)
+    int s = indexOf(startName);
+    int f = indexOf(finishName);
+    if (s < 0 || f < 0)
         throw std::runtime_error("Не найдена вершина при добавлении ребра.");
 
-    Edge<T> e(*s, *f, weight);
-    edges.push_back(e);
+    Edge e(s, f, weight);
+    if (!edgesStale)
+        edges.push_back(e);
+    if (!BucketQueue::accepts(weight))
+        ++nonSmallWeightEdges;
+    if (weight < 0.0)
+        ++negativeWeightEdges;
+    potentialsDirty = true;
+    graphVersion = nextGraphVersion();
+    heuristicScaleDirty = true;
 
     // Добавляем в out / in
-    s->out.push_back(e);
-    f->in.push_back(e);
+    vertices[s].out.push_back(e);
+    vertices[f].in.push_back(e);
 }
 
 template<typename T>
 void Graph<T>::removeEdge(const T& startName, const T& finishName)
 {
-    // Удаляем из общего списка edges
-    edges.erase(std::remove_if(edges.begin(), edges.end(),
-        [&](const Edge<T>& e){
-            return (e.start.name == startName && e.finish.name == finishName);
-        }), edges.end());
+    int s = indexOf(startName);
+    int f = indexOf(finishName);
+    if (s < 0 || f < 0)
+        return;
 
-    // Удаляем из out
-    Vertex<T>* s = findVertex(startName);
-    if (s)
+    auto same = [s, f](const Edge& e){
+        return (e.start == s && e.finish == f);
+    };
+
+    // Общий список edges не трогаем: он будет собран заново по запросу
+    auto& out = vertices[s].out;
+    bool negativeRemoved = false;
+    for (const Edge& e : out)
     {
-        s->out.erase(std::remove_if(s->out.begin(), s->out.end(),
-            [&](const Edge<T>& e){
-                return (e.start.name == startName && e.finish.name == finishName);
-            }), s->out.end());
+        if (!same(e))
+            continue;
+        uncountEdge(e);
+        negativeRemoved = negativeRemoved || e.weight < 0.0;
     }
+    edgesStale = true;
+    // Потенциалы Джонсона пересчитываются, только если изменился набор
+    // отрицательных рёбер
+    if (negativeRemoved)
+        potentialsDirty = true;
+    heuristicScaleDirty = true;
+    graphVersion = nextGraphVersion();
+
+    // Удаляем из out
+    out.erase(std::remove_if(out.begin(), out.end(), same), out.end());
 
     // Удаляем из in
-    Vertex<T>* f = findVertex(finishName);
-    if (f)
+    auto& in = vertices[f].in;
+    in.erase(std::remove_if(in.begin(), in.end(), same), in.end());
+}
+
+// -----------------------------------------------------------------
+//  Координаты вершин
+template<typename T>
+void Graph<T>::setVertexPosition(const T& name, double x, double y)
+{
+    Vertex<T>* v = findVertex(name);
+    if (!v)
+        throw std::runtime_error("Не найдена вершина при задании координат.");
+
+    if (!v->placed)
+        --unplacedVertices;
+    v->x = x;
+    v->y = y;
+    v->placed = true;
+    heuristicScaleDirty = true;
+}
+
+// Наибольший множитель k, при котором k * (евклидово расстояние) не
+// превышает вес ни одного ребра, — тогда эвристика A* допустима.
+// Пересчитывается за O(E) только после правок графа.
+template<typename T>
+double Graph<T>::euclideanScale()
+{
+    if (!heuristicScaleDirty)
+        return heuristicScale;
+
+    refreshEdges();
+    double scale = std::numeric_limits<double>::infinity();
+    for (const Edge& e : edges)
+    {
+        const Vertex<T>& a = vertices[e.start];
+        const Vertex<T>& b = vertices[e.finish];
+        double length = std::hypot(a.x - b.x, a.y - b.y);
+        if (length > 0.0)
+            scale = std::min(scale, e.weight / length);
+    }
+    // Рёбер нулевой длины нет — ограничений нет, но и рёбер, по которым
+    // эвристика что-то даёт, тоже: берём 0 (обычная Дейкстра)
+    if (scale == std::numeric_limits<double>::infinity() || scale < 0.0)
+        scale = 0.0;
+
+    // Небольшой запас, чтобы погрешность sqrt не нарушила согласованность
+    heuristicScale = scale * (1.0 - 1e-9);
+    heuristicScaleDirty = false;
+    return heuristicScale;
+}
+
+// Потенциалы Джонсона для графа с отрицательными весами; SPFA
+// запускается заново только после правок графа
+template<typename T>
+const std::vector<double>& Graph<T>::johnsonPotentials()
+{
+    if (potentialsDirty)
     {
-        f->in.erase(std::remove_if(f->in.begin(), f->in.end(),
-            [&](const Edge<T>& e){
-                return (e.start.name == startName && e.finish.name == finishName);
-            }), f->in.end());
+        if (!::johnsonPotentials(*this, potentials))
+            throw std::runtime_error("В графе есть цикл отрицательного веса.");
+        potentialsDirty = false;
     }
+    return potentials;
+}
+
+// -----------------------------------------------------------------
+//  Кэш деревьев кратчайших путей
+template<typename T>
+void Graph<T>::enablePathCache(std::size_t maxTrees)
+{
+    treeCache.setCapacity(maxTrees);
 }
 
 // -----------------------------------------------------------------
@@ -139,204 +280,233 @@ bool Graph<T>::containsVertex(const T& name) const
 // -----------------------------------------------------------------
 //  Алгоритм Дейкстры
 template<typename T>
-Path<T> Graph<T>::dijkstraPath(const T& startName, const T& finishName)
+Path<T> Graph<T>::dijkstraPath(const T& startName, const T& finishName, QueryWorkspace& ws)
 {
     // Если нет одной из вершин, возвращаем путь с -1
-    if (!containsVertex(startName) || !containsVertex(finishName))
-    {
-        DynamicArray<int> distArr;
-        DynamicArray<T> pathArr;
-        // Заполним distArr -1 (на каждую вершину)
-        int n = static_cast<int>(vertices.size());
-        for (int i = 0; i < n; ++i)
-            distArr.push_back(-1);
-
-        return Path<T>(distArr, pathArr);
-    }
-
-    // Словари: имя -> расстояние, имя -> предыдущая вершина
-    std::unordered_map<T, double> dist;
-    std::unordered_map<T, T> prev;
-
-    const double INF = std::numeric_limits<double>::infinity();
-
-    // Инициализация
-    for (auto& v : vertices)
-        dist[v.name] = INF;
-    dist[startName] = 0.0;
-
-    // priority_queue c компаратором (min-heap)
-    auto cmp = [](const std::pair<double, T>& a,
-                  const std::pair<double, T>& b)
+    int start = indexOf(startName);
+    int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    // Кэш включён: повторный источник — без поиска, при промахе ищем
+    // до всех вершин, чтобы дерево пригодилось и другим финишам
+    if (treeCache.enabled())
     {
-        return a.first > b.first;
-    };
-    std::priority_queue<
-        std::pair<double, T>,
-        std::vector<std::pair<double, T>>,
-        decltype(cmp)
-    > pq(cmp);
-
-    pq.push({0.0, startName});
-
-    while (!pq.empty())
-    {
-        auto [curDist, curName] = pq.top();
-        pq.pop();
-
-        if (curDist > dist[curName])
-            continue;
-        if (curName == finishName)
-            break;
-
-        Vertex<T>* curV = findVertex(curName);
-        if (!curV)
-            continue;
-
-        for (auto& edge : curV->out)
-        {
-            T neighName = edge.finish.name;
-            double alt = curDist + edge.weight;
-
-            if (alt < dist[neighName])
-            {
-                dist[neighName] = alt;
-                prev[neighName] = curName;
-                pq.push({alt, neighName});
-            }
-        }
+        const ShortestPathTree<T>* tree = treeCache.find(start, graphVersion);
+        if (!tree)
+            tree = &treeCache.insert(start, graphVersion, searchTree(start, ws));
+        return makeTreePath<T>(*this, finish, *tree);
     }
 
-    // Заполняем Path
-    DynamicArray<int> distArr;
-    DynamicArray<T> pathArr;
+    // Поиск идёт по индексам: ни хеширования, ни копий имён
+    if (hasNegativeWeights())
+        johnsonSearch(*this, johnsonPotentials(), start, finish, ws);
+    else
+        shortestPathSearch(*this, start, finish, ws);
 
-    // distArr по порядку вершин
-    for (auto& v : vertices)
-    {
-        double d = dist[v.name];
-        if (d == INF)
-            distArr.push_back(-1);
-        else
-            distArr.push_back(static_cast<int>(d));
-    }
+    return makePath<T>(*this, start, finish, ws);
+}
 
-    // Если финиш недостижим
-    if (dist[finishName] == INF)
+// Полный поиск из start, упакованный в дерево
+template<typename T>
+ShortestPathTree<T> Graph<T>::searchTree(int start, QueryWorkspace& ws)
+{
+    if (hasNegativeWeights())
+        johnsonSearch(*this, johnsonPotentials(), start, -1, ws);
+    else
+        shortestPathSearch(*this, start, -1, ws);
+
+    const int n = vertexCount();
+    std::vector<double> dist(n);
+    std::vector<int> prev(n);
+    for (int v = 0; v < n; ++v)
     {
-        return Path<T>(distArr, pathArr);
+        dist[v] = ws.distance(v);
+        prev[v] = ws.parent(v);
     }
+    return ShortestPathTree<T>(*this, start, std::move(dist), std::move(prev));
+}
 
-    // Восстанавливаем путь
+template<typename T>
+ShortestPathTree<T> Graph<T>::shortestPathTree(const T& sourceName, QueryWorkspace& ws)
+{
+    int start = indexOf(sourceName);
+    if (start < 0)
     {
-        T current = finishName;
-        while (true)
-        {
-            pathArr.push_back(current);
-            if (current == startName)
-                break;
-            current = prev[current];
-        }
-        // Разворачиваем (reverse)
-        int left = 0;
-        int right = static_cast<int>(pathArr.get_size()) - 1;
-        while (left < right)
-        {
-            T tmp = pathArr[left];
-            pathArr[left] = pathArr[right];
-            pathArr[right] = tmp;
-            ++left;
-            --right;
-        }
+        return ShortestPathTree<T>(*this, -1,
+                                   std::vector<double>(vertexCount(), std::numeric_limits<double>::infinity()),
+                                   std::vector<int>(vertexCount(), -1));
     }
-
-    return Path<T>(distArr, pathArr);
+    if (!treeCache.enabled())
+        return searchTree(start, ws);
+
+    // Из кэша — копия массивов, привязанная к этому графу
+    const ShortestPathTree<T>* tree = treeCache.find(start, graphVersion);
+    if (!tree)
+        tree = &treeCache.insert(start, graphVersion, searchTree(start, ws));
+    return ShortestPathTree<T>(*this, start, tree->distances(), tree->parents());
 }
 
 // -----------------------------------------------------------------
-//  DFS
+//  Беллман — Форд (SPFA)
 template<typename T>
-void Graph<T>::depthFirstSearch(const T& startName)
+Path<T> Graph<T>::bellmanFordPath(const T& startName, const T& finishName, QueryWorkspace& ws)
 {
-    Vertex<T>* startV = findVertex(startName);
-    if (!startV)
-    {
-        std::cerr << "DFS: вершина '" << startName << "' не найдена!\n";
-        return;
-    }
+    int start = indexOf(startName);
+    int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    if (!spfaSearch(*this, start, ws))
+        throw std::runtime_error("В графе есть цикл отрицательного веса.");
+    return makePath<T>(*this, start, finish, ws);
+}
 
-    std::vector<T> visited;
-    visited.reserve(vertices.size());
+template<typename T>
+Path<T> Graph<T>::bidirectionalDijkstraPath(const T& startName, const T& finishName,
+                                           QueryWorkspace& forward, QueryWorkspace& backward)
+{
+    int start = indexOf(startName);
+    int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    // Правило остановки двусторонней Дейкстры при отрицательных весах
+    // не работает
+    if (hasNegativeWeights())
+        return dijkstraPath(startName, finishName, forward);
+
+    int meet = bidirectionalShortestPathSearch(*this, start, finish, forward, backward);
+    return makeBidirectionalPath<T>(*this, meet, forward, backward);
+}
 
-    dfsUtil(*startV, visited);
+// -----------------------------------------------------------------
+//  A*
+template<typename T>
+Path<T> Graph<T>::aStarPath(const T& startName, const T& finishName, QueryWorkspace& ws)
+{
+    int start = indexOf(startName);
+    int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return makeMissingPath<T>(vertexCount());
+
+    // При отрицательных весах евклидова оценка не допустима
+    double scale = hasPositions() && !hasNegativeWeights() ? euclideanScale() : 0.0;
+    if (scale <= 0.0)
+        return dijkstraPath(startName, finishName, ws);
+
+    const Vertex<T>& target = vertices[finish];
+    aStarSearch(*this, start, finish, [&](int v){
+        const Vertex<T>& p = vertices[v];
+        return scale * std::hypot(p.x - target.x, p.y - target.y);
+    }, ws);
+
+    return makePath<T>(*this, start, finish, ws);
+}
 
-    // Вывод (пример)
-    std::cout << "DFS order: ";
-    for (auto& nm : visited)
-        std::cout << nm << " ";
-    std::cout << std::endl;
+// -----------------------------------------------------------------
+//  k кратчайших путей
+template<typename T>
+std::vector<Path<T>> Graph<T>::kShortestPaths(const T& startName, const T& finishName, int k,
+                                               QueryWorkspace& ws)
+{
+    std::vector<Path<T>> result;
+    int start = indexOf(startName);
+    int finish = indexOf(finishName);
+    if (start < 0 || finish < 0)
+        return result;
+
+    // При отрицательных весах длины всех путей start -> finish в
+    // перевзвешенном графе сдвинуты на одно и то же h(start) - h(finish)
+    std::vector<RankedRoute> routes;
+    if (hasNegativeWeights())
+        routes = yenKShortestPaths(ReweightedGraph<Graph<T>>(*this, johnsonPotentials()),
+                                   start, finish, k, ws);
+    else
+        routes = yenKShortestPaths(*this, start, finish, k, ws);
+
+    result.reserve(routes.size());
+    for (const RankedRoute& r : routes)
+        result.push_back(makeRoutePath<T>(*this, r.vertices));
+    return result;
 }
 
+// -----------------------------------------------------------------
+//  Матрица расстояний «многие ко многим»
 template<typename T>
-void Graph<T>::dfsUtil(Vertex<T>& v, std::vector<T>& visited)
+DistanceMatrix Graph<T>::distanceMatrix(const std::vector<T>& sources,
+                                        const std::vector<T>& targets,
+                                        int threadCount)
 {
-    visited.push_back(v.name);
+    std::vector<int> from;
+    std::vector<int> to;
+    from.reserve(sources.size());
+    to.reserve(targets.size());
+    for (const T& name : sources)
+        from.push_back(indexOf(name));
+    for (const T& name : targets)
+        to.push_back(indexOf(name));
+
+    // При отрицательных весах — потенциалы из кэша графа (SPFA только
+    // после правок); отрицательный цикл — исключение из johnsonPotentials
+    if (!hasNegativeWeights())
+        return dijkstraDistanceMatrix(*this, from, to, threadCount);
+    return johnsonDistanceMatrix(*this, johnsonPotentials(), from, to, threadCount);
+}
 
-    for (auto& edge : v.out)
-    {
-        Vertex<T>* nextV = findVertex(edge.finish.name);
-        if (!nextV)
-            continue;
-        if (std::find(visited.begin(), visited.end(), nextV->name) == visited.end())
-        {
-            dfsUtil(*nextV, visited);
-        }
-    }
+// -----------------------------------------------------------------
+//  DFS
+template<typename T>
+TraversalResult Graph<T>::depthFirstSearch(const T& startName, TraversalOptions options,
+                                           QueryWorkspace& ws) const
+{
+    return depthFirstTraversal(*this, indexOf(startName), options, ws);
 }
 
 // -----------------------------------------------------------------
 //  BFS
 template<typename T>
-void Graph<T>::breadthFirstSearch(const T& startName)
+TraversalResult Graph<T>::breadthFirstSearch(const T& startName, TraversalOptions options,
+                                             QueryWorkspace& ws) const
 {
-    Vertex<T>* startV = findVertex(startName);
-    if (!startV)
-    {
-        std::cerr << "BFS: вершина '" << startName << "' не найдена!\n";
-        return;
-    }
+    return breadthFirstTraversal(*this, indexOf(startName), options, ws);
+}
+
+// -----------------------------------------------------------------
+//  Ленивые обходы
+template<typename T>
+Generator<int> Graph<T>::lazyDepthFirstSearch(const T& startName) const
+{
+    return lazyDepthFirst(*this, indexOf(startName));
+}
 
-    std::vector<T> visited;
-    visited.reserve(vertices.size());
-    std::queue<Vertex<T>*> q;
+template<typename T>
+Generator<int> Graph<T>::lazyBreadthFirstSearch(const T& startName) const
+{
+    return lazyBreadthFirst(*this, indexOf(startName));
+}
 
-    visited.push_back(startV->name);
-    q.push(startV);
+// -----------------------------------------------------------------
+//  Компоненты слабой связности
+template<typename T>
+ComponentsResult Graph<T>::weaklyConnectedComponents(int threadCount) const
+{
+    return afforestComponents(*this, threadCount);
+}
 
-    while (!q.empty())
-    {
-        Vertex<T>* cur = q.front();
-        q.pop();
-
-        for (auto& edge : cur->out)
-        {
-            Vertex<T>* neighbor = findVertex(edge.finish.name);
-            if (!neighbor)
-                continue;
-
-            if (std::find(visited.begin(), visited.end(), neighbor->name) == visited.end())
-            {
-                visited.push_back(neighbor->name);
-                q.push(neighbor);
-            }
-        }
-    }
+// -----------------------------------------------------------------
+//  CSR-снимок
+template<typename T>
+CsrGraph<T> Graph<T>::freeze() const
+{
+    std::vector<T> names;
+    names.reserve(vertices.size());
+    for (auto& v : vertices)
+        names.push_back(v.name);
 
-    // Вывод (пример)
-    std::cout << "BFS order: ";
-    for (auto& nm : visited)
-        std::cout << nm << " ";
-    std::cout << std::endl;
+    if (edgesStale)
+        return CsrGraph<T>(std::move(names), collectEdges());
+    return CsrGraph<T>(std::move(names), edges);
 }
 
 // -----------------------------------------------------------------
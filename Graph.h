@@ -2,10 +2,24 @@
 #define GRAPH_H
 
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include "Vertex.h"
 #include "Edge.h"
 #include "Path.h"
+#include "CsrGraph.h"
+#include "Dijkstra.h"
+#include "QueryWorkspace.h"
+#include "BidirectionalDijkstra.h"
+#include "AStar.h"
+#include "DistanceMatrix.h"
+#include "NegativeWeights.h"
+#include "KShortestPaths.h"
+#include "PathCache.h"
+#include "Traversal.h"
+#include "Components.h"
 #include "DynamicArray.h"
 
 template<typename T>
@@ -13,7 +27,19 @@ class Graph
 {
 private:
     std::vector<Vertex<T>> vertices;  // Шаблонные вершины
-    std::vector<Edge<T>> edges;       // Шаблонные рёбра
+    std::vector<Edge> edges;          // Рёбра (индексы вершин + вес)
+    bool edgesStale = false;          // после removeEdge edges отстаёт от out-списков
+    std::unordered_map<T, int> indices; // Имя -> индекс в vertices
+    int nonSmallWeightEdges = 0;      // Рёбра с весом, не подходящим для BucketQueue
+    int negativeWeightEdges = 0;      // Рёбра с отрицательным весом
+    std::vector<double> potentials;   // Потенциалы Джонсона
+    bool potentialsDirty = true;      // пересчитать перед следующим запросом
+    std::uint64_t graphVersion = 0;   // новый номер (nextGraphVersion) при каждой правке
+    GraphLifetime alive;              // для деревьев путей: жив ли этот объект
+    ShortestPathCache<T> treeCache;      // деревья путей по источникам (по умолчанию выключен)
+    int unplacedVertices = 0;         // Вершины без координат
+    double heuristicScale = 0.0;      // min(вес / длина) по рёбрам, для A*
+    bool heuristicScaleDirty = true;  // пересчитать перед следующим A*
 
 public:
     Graph() = default;
@@ -22,6 +48,32 @@ public:
     // -- Вспомогательные --
     Vertex<T>* findVertex(const T& name);
     const Vertex<T>* findVertexConst(const T& name) const;
+    int indexOf(const T& name) const; // -1, если вершины нет
+
+    // -- Доступ по плотным индексам (для движков алгоритмов) --
+    int vertexCount() const { return static_cast<int>(vertices.size()); }
+    const T& vertexName(int idx) const { return vertices[idx].name; }
+
+    // f(индекс соседа, вес)
+    template<typename F>
+    void forEachOut(int u, F&& f) const
+    {
+        for (const Edge& e : vertices[u].out)
+            f(e.finish, e.weight);
+    }
+
+    template<typename F>
+    void forEachIn(int u, F&& f) const
+    {
+        for (const Edge& e : vertices[u].in)
+            f(e.start, e.weight);
+    }
+
+    // k-й исходящий сосед (для обходов с явным стеком)
+    int outDegree(int u) const { return static_cast<int>(vertices[u].out.size()); }
+    int outTarget(int u, int k) const { return vertices[u].out[k].finish; }
+    int inDegree(int u) const { return static_cast<int>(vertices[u].in.size()); }
+    int inSource(int u, int k) const { return vertices[u].in[k].start; }
 
     // -- Добавление/удаление вершин --
     void addVertex(const T& name);
@@ -34,15 +86,93 @@ public:
     // -- Проверка --
     bool containsVertex(const T& name) const;
 
+    // Все веса — целые 0..BucketQueue::MAX_WEIGHT (Дейкстра на корзинах)
+    bool hasSmallIntWeights() const { return nonSmallWeightEdges == 0; }
+
+    // Есть отрицательные веса: dijkstraPath сам переходит на перевзвешивание
+    // Джонсона, при отрицательном цикле — исключение
+    bool hasNegativeWeights() const { return negativeWeightEdges > 0; }
+
+    // Версия графа: новая при любом addVertex/removeVertex/addEdge/removeEdge.
+    // Номера общие для всех графов, так что совпадение версий значит
+    // совпадение содержимого (копия без правок)
+    std::uint64_t version() const { return graphVersion; }
+    std::weak_ptr<const void> lifetime() const { return alive.watch(); }
+
+    // -- Кэш деревьев кратчайших путей для dijkstraPath --
+    // До maxTrees источников (LRU); 0 — выключить. Повторный источник
+    // отвечается без поиска, после правки графа кэш сбрасывается сам.
+    void enablePathCache(std::size_t maxTrees);
+    const ShortestPathCache<T>& pathCache() const { return treeCache; }
+
+    // -- Координаты вершин (для A*) --
+    void setVertexPosition(const T& name, double x, double y);
+    bool hasPositions() const { return unplacedVertices == 0; }
+
     // -- Алгоритмы --
-    Path<T> dijkstraPath(const T& startName, const T& finishName);
+    // ws — рабочая память запроса; по умолчанию своя у каждого потока
+    Path<T> dijkstraPath(const T& startName, const T& finishName,
+                         QueryWorkspace& ws = QueryWorkspace::local());
+
+    // Дерево кратчайших путей из source: точные расстояния до всех вершин
+    // и пути до любой из них по запросу (учитывает кэш путей)
+    ShortestPathTree<T> shortestPathTree(const T& sourceName,
+                                         QueryWorkspace& ws = QueryWorkspace::local());
+
+    // Беллман — Форд с очередью (SPFA): любые веса, без предобработки
+    Path<T> bellmanFordPath(const T& startName, const T& finishName,
+                            QueryWorkspace& ws = QueryWorkspace::local());
+
+    // Двусторонняя Дейкстра (out из старта, in из финиша), тот же Path<T>
+    Path<T> bidirectionalDijkstraPath(const T& startName, const T& finishName,
+                                      QueryWorkspace& forward = QueryWorkspace::local(0),
+                                      QueryWorkspace& backward = QueryWorkspace::local(1));
+
+    // A* с евклидовой эвристикой; без координат — обычная Дейкстра
+    Path<T> aStarPath(const T& startName, const T& finishName,
+                      QueryWorkspace& ws = QueryWorkspace::local());
+
+    // До k простых путей по неубыванию длины (алгоритм Йена); у каждого
+    // Path<T> расстояния — длины префиксов вдоль этого пути
+    std::vector<Path<T>> kShortestPaths(const T& startName, const T& finishName, int k,
+                                        QueryWorkspace& ws = QueryWorkspace::local());
+
+    // Расстояния от каждой из sources до каждой из targets (row-major),
+    // один поиск на источник, строки считаются параллельно. При
+    // отрицательных весах берёт потенциалы Джонсона из кэша графа
+    DistanceMatrix distanceMatrix(const std::vector<T>& sources, const std::vector<T>& targets,
+                                  int threadCount = defaultThreadCount());
+
+    // Обходы: порядок посещения (и по запросу предки/глубины) по индексам
+    // вершин; нет стартовой вершины — пустой результат. Вывод — printTraversal
+    TraversalResult depthFirstSearch(const T& startName, TraversalOptions options = {},
+                                     QueryWorkspace& ws = QueryWorkspace::local()) const;
+    TraversalResult breadthFirstSearch(const T& startName, TraversalOptions options = {},
+                                       QueryWorkspace& ws = QueryWorkspace::local()) const;
+
+    // Ленивые обходы: индексы вершин по одной, работу можно прервать
+    // в любой момент (break, std::views::take, ...). Граф не править,
+    // пока генератор жив
+    Generator<int> lazyDepthFirstSearch(const T& startName) const;
+    Generator<int> lazyBreadthFirstSearch(const T& startName) const;
+
+    // Компоненты слабой связности (Afforest, параллельно): номер
+    // компоненты по индексу вершины и размеры компонент
+    ComponentsResult weaklyConnectedComponents(int threadCount = defaultThreadCount()) const;
 
-    // Обходы
-    void depthFirstSearch(const T& startName);
-    void breadthFirstSearch(const T& startName);
+    // -- Снимок для запросов --
+    // Неизменяемая CSR-копия текущего графа; после правок пересобрать заново
+    CsrGraph<T> freeze() const;
 
 private:
-    void dfsUtil(Vertex<T>& v, std::vector<T>& visited);
+    template<typename Pred>
+    void eraseEdges(Pred pred);
+    void uncountEdge(const Edge& e);
+    std::vector<Edge> collectEdges() const;
+    void refreshEdges();
+    double euclideanScale();
+    const std::vector<double>& johnsonPotentials();
+    ShortestPathTree<T> searchTree(int start, QueryWorkspace& ws);
 };
 
 #endif // GRAPH_H
@@ -0,0 +1,207 @@
+#ifndef K_SHORTEST_PATHS_H
+#define K_SHORTEST_PATHS_H
+
+#include <set>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <functional>
+#include "Path.h"
+#include "DynamicArray.h"
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+
+// k кратчайших простых путей (алгоритм Йена) на плотных индексах.
+// Путь k получается из пути k - 1 «ответвлением» в вершине spur:
+// корень (начало пути до spur) сохраняется, дальше — кратчайший путь
+// от spur до финиша, который не проходит через вершины корня и не
+// повторяет выходы из spur, уже использованные путями с тем же корнем.
+// Исключения — маски поверх исходного графа (MaskedGraph), а не копии.
+// Ответвления ищутся только начиная с точки, где сам путь k - 1
+// отделился от родителя (модификация Лоулера): более ранние уже были
+// перебраны, когда обрабатывали родителя.
+
+// Граф с выключенными вершинами и выключенными рёбрами из одной вершины
+template<typename G>
+class MaskedGraph
+{
+private:
+    const G& graph;
+    const std::vector<char>& removedVertex;
+    const std::vector<char>& blockedTarget;  // рёбра spur -> v
+    int spur;
+
+public:
+    MaskedGraph(const G& g, const std::vector<char>& removed,
+                const std::vector<char>& blocked, int spurVertex)
+        : graph(g), removedVertex(removed), blockedTarget(blocked), spur(spurVertex)
+    {
+    }
+
+    int vertexCount() const { return graph.vertexCount(); }
+    decltype(auto) vertexName(int idx) const { return graph.vertexName(idx); }
+    bool hasSmallIntWeights() const { return graph.hasSmallIntWeights(); }
+
+    template<typename F>
+    void forEachOut(int u, F&& f) const
+    {
+        graph.forEachOut(u, [&](int v, double w){
+            if (removedVertex[v] || (u == spur && blockedTarget[v]))
+                return;
+            f(v, w);
+        });
+    }
+};
+
+// Найденный путь: вершины и длина
+struct RankedRoute
+{
+    std::vector<int> vertices;
+    double cost = 0.0;
+    int deviation = 0;  // индекс вершины, в которой путь отделился от родителя
+};
+
+// Вес самого лёгкого ребра u -> v
+template<typename G>
+double edgeCost(const G& graph, int u, int v)
+{
+    double best = std::numeric_limits<double>::infinity();
+    graph.forEachOut(u, [&](int to, double w){
+        if (to == v && w < best)
+            best = w;
+    });
+    return best;
+}
+
+// До k путей start -> finish по неубыванию длины. Веса должны быть
+// неотрицательными (для отрицательных — перевзвешенный граф, см.
+// NegativeWeights.h: длины всех путей сдвигаются на одну константу).
+template<typename G>
+std::vector<RankedRoute> yenKShortestPaths(const G& graph, int start, int finish, int k,
+                                           QueryWorkspace& ws = QueryWorkspace::local())
+{
+    std::vector<RankedRoute> accepted;
+    if (k <= 0)
+        return accepted;
+
+    const int n = graph.vertexCount();
+    std::vector<char> removed(n, 0);
+    std::vector<char> blocked(n, 0);
+
+    // Кратчайший путь spur -> finish в маске; пусто, если его нет
+    auto spurSearch = [&](int spur, std::vector<int>& route) {
+        MaskedGraph<G> masked(graph, removed, blocked, spur);
+        shortestPathSearch(masked, spur, finish, ws);
+        route.clear();
+        if (ws.distance(finish) == std::numeric_limits<double>::infinity())
+            return std::numeric_limits<double>::infinity();
+        for (int v = finish; v != -1; v = ws.parent(v))
+            route.push_back(v);
+        std::reverse(route.begin(), route.end());
+        return ws.distance(finish);
+    };
+
+    RankedRoute first;
+    first.cost = spurSearch(start, first.vertices);
+    if (first.vertices.empty())
+        return accepted;
+    accepted.push_back(std::move(first));
+
+    // Кандидаты: куча (длина, номер в pool) + множество уже виденных путей
+    std::vector<RankedRoute> pool;
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> candidates;
+    std::set<std::vector<int>> seen;
+    seen.insert(accepted[0].vertices);
+
+    std::vector<int> spurRoute;
+    std::vector<double> prefix;  // длины корней предыдущего пути
+    while (static_cast<int>(accepted.size()) < k)
+    {
+        const RankedRoute& last = accepted.back();
+        const std::vector<int>& route = last.vertices;
+
+        prefix.assign(1, 0.0);
+        for (std::size_t i = 0; i + 1 < route.size(); ++i)
+            prefix.push_back(prefix.back() + edgeCost(graph, route[i], route[i + 1]));
+
+        for (int i = 0; i < last.deviation; ++i)
+            removed[route[i]] = 1;
+
+        for (int i = last.deviation; i + 1 < static_cast<int>(route.size()); ++i)
+        {
+            const int spur = route[i];
+
+            // Выходы из spur, занятые путями с тем же корнем
+            for (const RankedRoute& other : accepted)
+            {
+                const auto& p = other.vertices;
+                if (static_cast<int>(p.size()) > i + 1
+                    && std::equal(route.begin(), route.begin() + i + 1, p.begin()))
+                {
+                    blocked[p[i + 1]] = 1;
+                }
+            }
+
+            double spurCost = spurSearch(spur, spurRoute);
+            if (!spurRoute.empty())
+            {
+                RankedRoute candidate;
+                candidate.vertices.assign(route.begin(), route.begin() + i);
+                candidate.vertices.insert(candidate.vertices.end(), spurRoute.begin(), spurRoute.end());
+                if (seen.insert(candidate.vertices).second)
+                {
+                    candidate.cost = prefix[i] + spurCost;
+                    candidate.deviation = i;
+                    candidates.push({candidate.cost, static_cast<int>(pool.size())});
+                    pool.push_back(std::move(candidate));
+                }
+            }
+
+            // Снимаем маску выходов, вершина spur уходит в корень
+            for (const RankedRoute& other : accepted)
+            {
+                const auto& p = other.vertices;
+                if (static_cast<int>(p.size()) > i + 1)
+                    blocked[p[i + 1]] = 0;
+            }
+            removed[spur] = 1;
+        }
+        for (int v : route)
+            removed[v] = 0;
+
+        if (candidates.empty())
+            break;
+        int best = candidates.top().second;
+        candidates.pop();
+        accepted.push_back(std::move(pool[best]));
+    }
+    return accepted;
+}
+
+// Упаковка пути в Path<T>: расстояния — длины префиксов вдоль самого
+// пути (по исходным весам), у остальных вершин -1
+template<typename T, typename G>
+Path<T> makeRoutePath(const G& graph, const std::vector<int>& route)
+{
+    const int n = graph.vertexCount();
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+    for (int i = 0; i < n; ++i)
+        distArr.push_back(-1);
+
+    double d = 0.0;
+    for (std::size_t i = 0; i < route.size(); ++i)
+    {
+        if (i > 0)
+            d += edgeCost(graph, route[i - 1], route[i]);
+        distArr[route[i]] = static_cast<int>(d);
+        pathArr.push_back(graph.vertexName(route[i]));
+    }
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+#endif // K_SHORTEST_PATHS_H
@@ -0,0 +1,249 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Path.h"
+#include "QueryWorkspace.h"
+#include "Dijkstra.h"
+#include "AStar.h"
+#include "Parallel.h"
+
+// ALT (A*, Landmarks, Triangle inequality) для многократных запросов
+// «точка — точка» на редко меняющемся графе.
+// Предобработка выбирает k опорных вершин L и хранит d(L, v) и d(v, L)
+// для всех v. По неравенству треугольника
+//   d(v, t) >= d(L, t) - d(L, v)   и   d(v, t) >= d(v, L) - d(t, L),
+// максимум этих оценок по всем L — согласованная эвристика для A*.
+// Таблицы привязаны к индексам вершин конкретного CsrGraph<T>: после
+// правок графа индекс нужно построить (или загрузить) заново.
+// Веса должны быть неотрицательными: иначе оценки не являются нижними
+// границами (для таких графов — CsrGraph<T>::dijkstraPath с Джонсоном).
+
+template<typename T>
+class LandmarkIndex
+{
+private:
+    int vertexCount = 0;
+    int edgeCount = 0;          // вместе с vertexCount — проверка, что граф тот же
+    std::vector<int> landmarks;
+    // Таблицы «вершина за вершиной»: k расстояний вершины v лежат подряд
+    // в [v * k, (v + 1) * k), чтобы эвристика читала одну строку
+    std::vector<double> fromLandmark;   // d(L_i, v)
+    std::vector<double> toLandmark;     // d(v, L_i)
+
+    void copyLabels(std::vector<double>& table, int column, const QueryWorkspace& ws)
+    {
+        const int k = landmarkCount();
+        for (int v = 0; v < vertexCount; ++v)
+            table[static_cast<std::size_t>(v) * k + column] = ws.distance(v);
+    }
+
+    static void requireNonNegative(const CsrGraph<T>& graph)
+    {
+        if (graph.hasNegativeWeights())
+            throw std::runtime_error("ALT не поддерживает отрицательные веса.");
+    }
+
+public:
+    LandmarkIndex() = default;
+
+    // Предобработка: k опорных вершин выбираются «самыми дальними»
+    // (следующая — та, что дальше всех от уже выбранных; недостижимые
+    // считаются бесконечно далёкими, так покрываются все компоненты).
+    // Выбор идёт последовательно, а обратные таблицы d(v, L) считаются
+    // параллельно по опорным вершинам.
+    LandmarkIndex(const CsrGraph<T>& graph, int k, int threadCount = defaultThreadCount())
+        : vertexCount(graph.vertexCount()), edgeCount(graph.edgeCount())
+    {
+        requireNonNegative(graph);
+        const double INF = std::numeric_limits<double>::infinity();
+        k = std::min(k, vertexCount);
+        fromLandmark.assign(static_cast<std::size_t>(vertexCount) * k, INF);
+        toLandmark.assign(static_cast<std::size_t>(vertexCount) * k, INF);
+        if (k <= 0)
+            return;
+
+        // Минимальное расстояние от уже выбранных опорных вершин
+        std::vector<double> nearest(vertexCount, INF);
+        QueryWorkspace& ws = QueryWorkspace::local();
+        int next = 0;
+        landmarks.assign(k, -1);  // ширина строк таблиц — сразу k
+        for (int i = 0; i < k; ++i)
+        {
+            landmarks[i] = next;
+            dijkstraSearch(graph, next, -1, ws);
+            copyLabels(fromLandmark, i, ws);
+
+            nearest[next] = -1.0;  // уже опорная
+            int farthest = -1;
+            for (int v = 0; v < vertexCount; ++v)
+            {
+                if (nearest[v] < 0.0)
+                    continue;
+                nearest[v] = std::min(nearest[v], ws.distance(v));
+                if (farthest < 0 || nearest[v] > nearest[farthest])
+                    farthest = v;
+            }
+            if (farthest < 0)
+                break;
+            next = farthest;
+        }
+
+        // d(v, L) — поиск из L по входящим рёбрам
+        ReversedGraph<CsrGraph<T>> reversed(graph);
+        parallelFor(landmarkCount(), threadCount, [&](int i){
+            QueryWorkspace& local = QueryWorkspace::local();
+            dijkstraSearch(reversed, landmarks[i], -1, local);
+            copyLabels(toLandmark, i, local);
+        });
+    }
+
+    int landmarkCount() const { return static_cast<int>(landmarks.size()); }
+    const std::vector<int>& landmarkVertices() const { return landmarks; }
+
+    // Нижняя оценка d(v, target)
+    double lowerBound(int v, int target) const
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const int k = landmarkCount();
+        const double* fromV = &fromLandmark[static_cast<std::size_t>(v) * k];
+        const double* fromT = &fromLandmark[static_cast<std::size_t>(target) * k];
+        const double* toV = &toLandmark[static_cast<std::size_t>(v) * k];
+        const double* toT = &toLandmark[static_cast<std::size_t>(target) * k];
+
+        double bound = 0.0;
+        for (int i = 0; i < k; ++i)
+        {
+            if (fromT[i] != INF && fromV[i] != INF)
+                bound = std::max(bound, fromT[i] - fromV[i]);
+            if (toV[i] != INF && toT[i] != INF)
+                bound = std::max(bound, toV[i] - toT[i]);
+        }
+        return bound;
+    }
+
+    // Запрос «точка — точка»: A* с оценками по опорным вершинам
+    Path<T> query(const CsrGraph<T>& graph, const T& startName, const T& finishName,
+                  QueryWorkspace& ws = QueryWorkspace::local()) const
+    {
+        if (graph.vertexCount() != vertexCount || graph.edgeCount() != edgeCount)
+            throw std::runtime_error("Индекс ALT построен для другого графа.");
+        requireNonNegative(graph);
+
+        const int start = graph.indexOf(startName);
+        const int finish = graph.indexOf(finishName);
+        if (start < 0 || finish < 0)
+            return makeMissingPath<T>(vertexCount);
+
+        aStarSearch(graph, start, finish, [&](int v){
+            return lowerBound(v, finish);
+        }, ws);
+        return makePath<T>(graph, start, finish, ws);
+    }
+
+    // -- Сохранение рядом с файлом графа (например, input.txt.alt) --
+    // Формат: "ALT V E k", строка индексов опорных вершин, затем V строк
+    // по 2k чисел: d(L_1..L_k, v), d(v, L_1..L_k); бесконечность — "inf".
+    void save(const std::string& fileName) const
+    {
+        std::ofstream out(fileName);
+        if (!out)
+            throw std::runtime_error("Не удалось открыть файл для записи: " + fileName);
+
+        const int k = landmarkCount();
+        out.precision(std::numeric_limits<double>::max_digits10);
+        out << "ALT " << vertexCount << " " << edgeCount << " " << k << "\n";
+        for (int i = 0; i < k; ++i)
+            out << landmarks[i] << (i + 1 < k ? " " : "");
+        out << "\n";
+
+        auto write = [&out](double d) {
+            if (d == std::numeric_limits<double>::infinity())
+                out << "inf";
+            else
+                out << d;
+        };
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            for (int i = 0; i < k; ++i)
+            {
+                write(fromLandmark[static_cast<std::size_t>(v) * k + i]);
+                out << " ";
+            }
+            for (int i = 0; i < k; ++i)
+            {
+                write(toLandmark[static_cast<std::size_t>(v) * k + i]);
+                out << (i + 1 < k ? " " : "");
+            }
+            out << "\n";
+        }
+        if (!out)
+            throw std::runtime_error("Ошибка записи файла: " + fileName);
+    }
+
+    static LandmarkIndex load(const std::string& fileName)
+    {
+        std::ifstream in(fileName);
+        if (!in)
+            throw std::runtime_error("Не удалось открыть файл: " + fileName);
+
+        std::string tag;
+        int n = 0;
+        int m = 0;
+        int k = 0;
+        in >> tag >> n >> m >> k;
+        if (!in || tag != "ALT" || n < 0 || m < 0 || k < 0 || k > n)
+            throw std::runtime_error("Неверный формат файла ALT: " + fileName);
+
+        LandmarkIndex index;
+        index.vertexCount = n;
+        index.edgeCount = m;
+        index.landmarks.resize(k);
+        for (int& l : index.landmarks)
+        {
+            if (!(in >> l))
+                throw std::runtime_error("Файл ALT обрезан: " + fileName);
+            if (l < 0 || l >= n)
+                throw std::runtime_error("Неверная опорная вершина в файле ALT: " + fileName);
+        }
+
+        auto read = [&in, &fileName]() {
+            std::string token;
+            if (!(in >> token))
+                throw std::runtime_error("Файл ALT обрезан: " + fileName);
+            if (token == "inf")
+                return std::numeric_limits<double>::infinity();
+            std::size_t used = 0;
+            double d = 0.0;
+            try
+            {
+                d = std::stod(token, &used);
+            }
+            catch (const std::exception&)
+            {
+                used = 0;
+            }
+            if (used != token.size())
+                throw std::runtime_error("Неверное число в файле ALT: " + fileName);
+            return d;
+        };
+        index.fromLandmark.resize(static_cast<std::size_t>(n) * k);
+        index.toLandmark.resize(static_cast<std::size_t>(n) * k);
+        for (int v = 0; v < n; ++v)
+        {
+            for (int i = 0; i < k; ++i)
+                index.fromLandmark[static_cast<std::size_t>(v) * k + i] = read();
+            for (int i = 0; i < k; ++i)
+                index.toLandmark[static_cast<std::size_t>(v) * k + i] = read();
+        }
+        return index;
+    }
+};
+
+#endif // LANDMARKS_H
@@ -0,0 +1,224 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <bit>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Пакетный BFS из многих источников (MS-BFS, Then et al.): до Width
+// источников обходятся одним проходом по графу. У каждой вершины три
+// маски по Width бит: seen — какие источники её уже нашли, visit —
+// для каких она во фронте сейчас, next — на следующем уровне. Ребро
+// u -> v просматривается один раз на уровень сразу для всех источников:
+// next[v] |= visit[u] & ~seen[v]. Так вершины, общие для многих
+// обходов, читаются один раз вместо Width раз.
+// Width = 64 — одно машинное слово, 256 — четыре слова (одна операция
+// AVX2 при сборке с -mavx2, см. LAB4_AVX2). Пакеты независимы и
+// считаются параллельно. Снимок графа передаётся в run/runAll, объект
+// его не хранит.
+
+template<int Words>
+struct SourceMask
+{
+    std::uint64_t word[Words] = {};
+
+    bool any() const
+    {
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(word));
+            return !_mm256_testz_si256(x, x);
+        }
+#endif
+        std::uint64_t acc = 0;
+        for (int i = 0; i < Words; ++i)
+            acc |= word[i];
+        return acc != 0;
+    }
+
+    void set(int bit) { word[bit >> 6] |= std::uint64_t(1) << (bit & 63); }
+
+    // Новые для target биты: from & ~target; true, если такие есть.
+    // Сами биты добавляются в into
+    static bool spread(const SourceMask& from, const SourceMask& target, SourceMask& into)
+    {
+#if defined(__AVX2__)
+        if constexpr (Words == 4)
+        {
+            __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from.word));
+            __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target.word));
+            __m256i d = _mm256_andnot_si256(t, f);
+            if (_mm256_testz_si256(d, d))
+                return false;
+            __m256i* out = reinterpret_cast<__m256i*>(into.word);
+            _mm256_storeu_si256(out, _mm256_or_si256(_mm256_loadu_si256(out), d));
+            return true;
+        }
+#endif
+        std::uint64_t acc = 0;
+        for (int i = 0; i < Words; ++i)
+        {
+            std::uint64_t d = from.word[i] & ~target.word[i];
+            into.word[i] |= d;
+            acc |= d;
+        }
+        return acc != 0;
+    }
+};
+
+// Результат по источникам в порядке запроса (и по вершинам графа)
+struct MultiSourceBfsResult
+{
+    std::vector<int> sources;
+    std::vector<std::vector<int>> levels;  // levels[i][v], -1 — недостижима; пусто без keepLevels
+    std::vector<int> reachable;            // сколько вершин достижимо из sources[i], без неё самой
+    std::vector<long long> distanceSum;    // сумма уровней достижимых вершин
+    std::vector<int> eccentricity;         // наибольший уровень
+    std::vector<int> reachedBy;            // по вершине: из скольких источников достижима
+
+    // Близость sources[i]: достижимые / сумма расстояний до них
+    // (на связном графе — классическая (n - 1) / sum); 0, если никого
+    double closeness(int i) const
+    {
+        return distanceSum[i] == 0 ? 0.0
+                                   : static_cast<double>(reachable[i]) / static_cast<double>(distanceSum[i]);
+    }
+};
+
+template<typename T, int Width = 64>
+class MultiSourceBfs
+{
+    static_assert(Width > 0 && Width % 64 == 0, "Width должен быть кратен 64");
+
+private:
+    static constexpr int WORDS = Width / 64;
+    using Mask = SourceMask<WORDS>;
+
+    // Один пакет: sources[offset .. offset + count)
+    static void runBatch(const CsrGraph<T>& graph, const std::vector<int>& sources, int offset,
+                         int count, bool keepLevels, MultiSourceBfsResult& result,
+                         std::vector<int>& reachedBy)
+    {
+        const int n = graph.vertexCount();
+        std::vector<Mask> seen(n), visit(n), next(n);
+        std::vector<int> active, upcoming;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int s = sources[offset + i];
+            if (s < 0 || s >= n)
+                continue;
+            if (!seen[s].any())
+                active.push_back(s);
+            seen[s].set(i);
+            visit[s].set(i);
+            if (keepLevels)
+                result.levels[offset + i][s] = 0;
+        }
+
+        for (int depth = 1; !active.empty(); ++depth)
+        {
+            upcoming.clear();
+            for (int u : active)
+            {
+                const int degree = graph.outDegree(u);
+                for (int k = 0; k < degree; ++k)
+                {
+                    const int v = graph.outTarget(u, k);
+                    const bool fresh = !next[v].any();
+                    if (Mask::spread(visit[u], seen[v], next[v]) && fresh)
+                        upcoming.push_back(v);
+                }
+            }
+
+            for (int u : active)
+                visit[u] = Mask();
+            for (int v : upcoming)
+            {
+                for (int w = 0; w < WORDS; ++w)
+                {
+                    std::uint64_t bits = next[v].word[w];
+                    seen[v].word[w] |= bits;
+                    for (; bits; bits &= bits - 1)
+                    {
+                        const int i = offset + w * 64 + std::countr_zero(bits);
+                        ++result.reachable[i];
+                        result.distanceSum[i] += depth;
+                        result.eccentricity[i] = depth;
+                        if (keepLevels)
+                            result.levels[i][v] = depth;
+                    }
+                }
+                visit[v] = next[v];
+                next[v] = Mask();
+            }
+            active.swap(upcoming);
+        }
+
+        for (int v = 0; v < n; ++v)
+        {
+            for (int w = 0; w < WORDS; ++w)
+                reachedBy[v] += std::popcount(seen[v].word[w]);
+        }
+    }
+
+public:
+    MultiSourceBfs() = default;
+
+    // sources — индексы вершин (-1 — нет такой: ничего не достижимо).
+    // keepLevels = false — только агрегаты, без массивов уровней
+    // (V int на источник)
+    MultiSourceBfsResult run(const CsrGraph<T>& graph, const std::vector<int>& sources,
+                             bool keepLevels = true, int threadCount = defaultThreadCount()) const
+    {
+        const int n = graph.vertexCount();
+        const int total = static_cast<int>(sources.size());
+
+        MultiSourceBfsResult result;
+        result.sources = sources;
+        if (keepLevels)
+            result.levels.assign(total, std::vector<int>(n, -1));
+        result.reachable.assign(total, 0);
+        result.distanceSum.assign(total, 0);
+        result.eccentricity.assign(total, 0);
+        result.reachedBy.assign(n, 0);
+
+        // Пакеты пишут в непересекающиеся строки результата; счётчики
+        // по вершинам у каждого пакета свои и сливаются под мьютексом
+        std::mutex merge;
+        const int batches = (total + Width - 1) / Width;
+        parallelFor(batches, threadCount, [&](int b) {
+            const int offset = b * Width;
+            const int count = std::min(Width, total - offset);
+            std::vector<int> reachedBy(n, 0);
+            runBatch(graph, sources, offset, count, keepLevels, result, reachedBy);
+
+            std::lock_guard<std::mutex> lock(merge);
+            for (int v = 0; v < n; ++v)
+                result.reachedBy[v] += reachedBy[v];
+        });
+        return result;
+    }
+
+    // Все вершины графа как источники
+    MultiSourceBfsResult runAll(const CsrGraph<T>& graph, bool keepLevels = false,
+                                int threadCount = defaultThreadCount()) const
+    {
+        std::vector<int> sources(graph.vertexCount());
+        for (int v = 0; v < graph.vertexCount(); ++v)
+            sources[v] = v;
+        return run(graph, sources, keepLevels, threadCount);
+    }
+};
+
+#endif // MULTI_SOURCE_BFS_H
@@ -0,0 +1,159 @@
+#ifndef NEGATIVE_WEIGHTS_H
+#define NEGATIVE_WEIGHTS_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include "QueryWorkspace.h"
+#include "PriorityQueues.h"
+#include "Dijkstra.h"
+
+// Кратчайшие пути при отрицательных весах рёбер.
+// spfaSearch — Беллман — Форд с очередью (SPFA): в очередь попадают
+// только вершины, чья метка улучшилась, и поиск заканчивается, как
+// только очередь опустела (обычно задолго до V проходов).
+// Отрицательный цикл ловится по длине пути в рёбрах: если цепочка
+// родителей вершины достигла V рёбер, в ней есть цикл.
+// Для многократных запросов — перевзвешивание Джонсона: потенциалы
+// h(v) = d(виртуальный источник, v) делают веса w + h(u) - h(v)
+// неотрицательными, и дальше работает обычная Дейкстра.
+// В Path<T> расстояния усекаются до int, поэтому настоящее расстояние
+// -1 там неотличимо от «недостижима».
+
+// Поиск из start (start < 0 — из всех вершин сразу с меткой 0, как из
+// виртуального источника, соединённого со всеми рёбрами веса 0).
+// Метки dist/prev — в ws. false — достижим отрицательный цикл
+// (метки тогда не имеют смысла).
+template<typename G>
+bool spfaSearch(const G& graph, int start, QueryWorkspace& ws)
+{
+    const int n = graph.vertexCount();
+    ws.reset(n);
+    if (n == 0)
+        return true;
+
+    // Кольцевая очередь: каждая вершина стоит в ней не более одного раза
+    std::vector<int> queue(n);
+    std::vector<char> queued(n, 0);
+    std::vector<int> hops(n, 0);   // рёбер в текущем пути до вершины
+    int head = 0;
+    int count = 0;
+    auto enqueue = [&](int v) {
+        queue[(head + count) % n] = v;
+        ++count;
+        queued[v] = 1;
+    };
+
+    if (start >= 0)
+    {
+        ws.setLabel(start, 0.0, -1);
+        enqueue(start);
+    }
+    else
+    {
+        for (int v = 0; v < n; ++v)
+        {
+            ws.setLabel(v, 0.0, -1);
+            enqueue(v);
+        }
+    }
+
+    while (count > 0)
+    {
+        int cur = queue[head];
+        head = (head + 1) % n;
+        --count;
+        queued[cur] = 0;
+
+        const double curDist = ws.distance(cur);
+        bool cycle = false;
+        graph.forEachOut(cur, [&](int neigh, double weight){
+            double alt = curDist + weight;
+            if (cycle || !(alt < ws.distance(neigh)))
+                return;
+            ws.setLabel(neigh, alt, cur);
+            hops[neigh] = hops[cur] + 1;
+            if (hops[neigh] >= n)
+            {
+                cycle = true;
+                return;
+            }
+            if (!queued[neigh])
+                enqueue(neigh);
+        });
+        if (cycle)
+            return false;
+    }
+    return true;
+}
+
+// Потенциалы Джонсона; false — в графе есть отрицательный цикл
+template<typename G>
+bool johnsonPotentials(const G& graph, std::vector<double>& potentials,
+                       QueryWorkspace& ws = QueryWorkspace::local())
+{
+    potentials.clear();
+    if (!spfaSearch(graph, -1, ws))
+        return false;
+
+    const int n = graph.vertexCount();
+    potentials.resize(n);
+    for (int v = 0; v < n; ++v)
+        potentials[v] = ws.distance(v);
+    return true;
+}
+
+// Граф с весами w(u, v) + h(u) - h(v) >= 0 (погрешность округления
+// срезается до нуля, чтобы не сломать Дейкстру)
+template<typename G>
+class ReweightedGraph
+{
+private:
+    const G& graph;
+    const std::vector<double>& h;
+
+public:
+    ReweightedGraph(const G& g, const std::vector<double>& potentials)
+        : graph(g), h(potentials)
+    {
+    }
+
+    int vertexCount() const { return graph.vertexCount(); }
+    decltype(auto) vertexName(int idx) const { return graph.vertexName(idx); }
+    bool hasSmallIntWeights() const { return false; }
+
+    template<typename F>
+    void forEachOut(int u, F&& f) const
+    {
+        graph.forEachOut(u, [&](int v, double w){
+            f(v, std::max(0.0, w + h[u] - h[v]));
+        });
+    }
+
+    template<typename F>
+    void forEachIn(int u, F&& f) const
+    {
+        graph.forEachIn(u, [&](int v, double w){
+            f(v, std::max(0.0, w + h[v] - h[u]));
+        });
+    }
+};
+
+// Дейкстра по перевзвешенному графу; метки в ws переводятся обратно
+// в настоящие расстояния, так что дальше годится обычный makePath
+template<typename G>
+void johnsonSearch(const G& graph, const std::vector<double>& potentials,
+                   int start, int finish, QueryWorkspace& ws)
+{
+    dijkstraSearch(ReweightedGraph<G>(graph, potentials), start, finish, ws);
+
+    const int n = graph.vertexCount();
+    for (int v = 0; v < n; ++v)
+    {
+        if (ws.touched(v))
+            ws.setLabel(v, ws.distance(v) - potentials[start] + potentials[v], ws.parent(v));
+    }
+}
+
+#endif // NEGATIVE_WEIGHTS_H
@@ -0,0 +1,200 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+// Простейший параллельный цикл для предобработки и пакетных запросов.
+// Каждому потоку достаются свои QueryWorkspace::local() и localQueue(),
+// поэтому тело цикла может спокойно запускать поиски.
+
+inline int defaultThreadCount()
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+// body(i) для i из [0, count); индексы раздаются динамически, так что
+// неравные по стоимости итерации не тормозят друг друга.
+// Первое исключение из тела цикла пробрасывается вызывающему.
+template<typename F>
+void parallelFor(int count, int threadCount, F&& body)
+{
+    threadCount = std::min(threadCount, count);
+    if (threadCount <= 1)
+    {
+        for (int i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    std::atomic<int> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        try
+        {
+            for (int i = next++; i < count; i = next++)
+                body(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (int t = 1; t < threadCount; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+// -----------------------------------------------------------------
+//  Пул из постоянных потоков для алгоритмов, которые много раз подряд
+//  делают короткие параллельные фазы (создавать потоки на каждую фазу
+//  слишком дорого). run(f) вызывает f(threadId) на всех threadCount
+//  потоках (вызывающий — поток 0) и ждёт, пока все закончат.
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(int)> job;
+    long long generation = 0;     // номер текущей фазы
+    int pending = 0;              // сколько рабочих ещё не закончили фазу
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop(int id)
+    {
+        long long seen = 0;
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]{ return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            lock.unlock();
+
+            try
+            {
+                job(id);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+
+            lock.lock();
+            if (--pending == 0)
+                done.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPool(int threadCount = defaultThreadCount())
+    {
+        threadCount = std::max(threadCount, 1);
+        workers.reserve(threadCount - 1);
+        for (int id = 1; id < threadCount; ++id)
+            workers.emplace_back([this, id]{ workerLoop(id); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers)
+            w.join();
+    }
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    template<typename F>
+    void run(F&& f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = std::forward<F>(f);
+            pending = static_cast<int>(workers.size());
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        std::exception_ptr own;
+        try
+        {
+            job(0);
+        }
+        catch (...)
+        {
+            own = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]{ return pending == 0; });
+        if (own)
+            std::rethrow_exception(own);
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+// parallelFor на потоках пула: для циклов, которые идут фаза за фазой
+// (блоки Флойда — Уоршелла), без создания потоков на каждую фазу
+template<typename F>
+void parallelFor(ThreadPool& pool, int count, F&& body)
+{
+    if (count <= 0)
+        return;
+    if (pool.size() == 1 || count == 1)
+    {
+        for (int i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    std::atomic<int> next{0};
+    pool.run([&](int) {
+        try
+        {
+            for (int i = next++; i < count; i = next++)
+                body(i);
+        }
+        catch (...)
+        {
+            next = count;
+            throw;
+        }
+    });
+}
+
+#endif // PARALLEL_H
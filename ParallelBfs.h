@@ -0,0 +1,213 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <atomic>
+#include <vector>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "CsrGraph.h"
+#include "Parallel.h"
+
+// Параллельный BFS с выбором направления (Beamer, Asanović, Patterson).
+// Уровень обрабатывается одним из двух способов:
+//  - сверху вниз: вершины фронта (очередь) просматривают исходящие
+//    рёбра, новую вершину забирает тот поток, чей CAS по level прошёл;
+//    найденные вершины копятся в локальных очередях потоков;
+//  - снизу вверх: каждая ещё не посещённая вершина ищет среди входящих
+//    рёбер соседа из фронта (битовая карта) и останавливается на первом.
+//    Потоки владеют целыми 64-битными словами карты, атомики не нужны.
+// Сверху вниз выгоднее на малых фронтах, снизу вверх — на огромных
+// фронтах «маленького мира», где почти все рёбра ведут в посещённые.
+// Переход: вниз -> вверх, когда рёбер фронта m_f больше m_u / alpha
+// (m_u — входящие рёбра непосещённых вершин); обратно — когда во фронте
+// меньше n / beta вершин.
+// Объект хранит только настройки alpha/beta: снимок графа передаётся
+// в каждый run, так что временный freeze() ничего не оставляет висеть.
+
+struct BfsStats
+{
+    int topDownSteps = 0;
+    int bottomUpSteps = 0;
+};
+
+template<typename T>
+class DirectionOptimizingBfs
+{
+private:
+    static constexpr std::size_t QUEUE_CHUNK = 64;   // вершин фронта на захват
+    static constexpr std::size_t WORD_CHUNK = 16;    // слов карты (по 64 вершины) на захват
+
+    double alpha;
+    double beta;
+
+public:
+    // Значения по умолчанию — из статьи Beamer et al.
+    explicit DirectionOptimizingBfs(double alphaFactor = 15.0, double betaFactor = 18.0)
+        : alpha(alphaFactor), beta(betaFactor)
+    {
+    }
+
+    // Уровни (число рёбер от source), -1 — недостижима
+    std::vector<int> run(const CsrGraph<T>& graph, int source, ThreadPool& pool,
+                         BfsStats* stats = nullptr) const
+    {
+        const int n = graph.vertexCount();
+        const int threads = pool.size();
+        std::vector<std::atomic<int>> level(n);
+        for (auto& l : level)
+            l.store(-1, std::memory_order_relaxed);
+
+        if (source >= 0 && source < n)
+            search(graph, source, level, pool, threads, stats);
+
+        std::vector<int> result(n);
+        for (int v = 0; v < n; ++v)
+            result[v] = level[v].load(std::memory_order_relaxed);
+        return result;
+    }
+
+    // Нет такой вершины — все -1
+    std::vector<int> levels(const CsrGraph<T>& graph, const T& sourceName, ThreadPool& pool) const
+    {
+        return run(graph, graph.indexOf(sourceName), pool);
+    }
+
+private:
+    void search(const CsrGraph<T>& graph, int source, std::vector<std::atomic<int>>& level, ThreadPool& pool,
+                int threads, BfsStats* stats) const
+    {
+        const int n = graph.vertexCount();
+        const std::size_t words = (static_cast<std::size_t>(n) + 63) / 64;
+
+        std::vector<int> queue;                    // фронт сверху вниз
+        std::vector<std::uint64_t> current(words); // фронт снизу вверх
+        std::vector<std::uint64_t> next(words);
+        std::vector<std::vector<int>> local(threads);
+
+        level[source].store(0, std::memory_order_relaxed);
+        queue.push_back(source);
+
+        long long frontierSize = 1;
+        long long frontierEdges = graph.outDegree(source);
+        long long unexploredEdges = static_cast<long long>(graph.edgeCount()) - graph.inDegree(source);
+        bool bottomUp = false;
+
+        for (int depth = 0; frontierSize > 0; ++depth)
+        {
+            if (!bottomUp && frontierEdges * alpha > unexploredEdges)
+            {
+                std::fill(current.begin(), current.end(), 0);
+                for (int v : queue)
+                    current[v >> 6] |= std::uint64_t(1) << (v & 63);
+                bottomUp = true;
+            }
+            else if (bottomUp && frontierSize * beta < n)
+            {
+                queue.clear();
+                for (std::size_t w = 0; w < words; ++w)
+                {
+                    for (std::uint64_t bits = current[w]; bits; bits &= bits - 1)
+                        queue.push_back(static_cast<int>(w * 64 + std::countr_zero(bits)));
+                }
+                bottomUp = false;
+            }
+
+            std::atomic<long long> found{0};
+            std::atomic<long long> foundOutEdges{0};
+            std::atomic<long long> foundInEdges{0};
+            std::atomic<std::size_t> nextChunk{0};
+            const int nextLevel = depth + 1;
+
+            if (bottomUp)
+            {
+                pool.run([&](int) {
+                    long long count = 0, outEdges = 0, inEdges = 0;
+                    for (std::size_t begin = nextChunk.fetch_add(WORD_CHUNK); begin < words;
+                         begin = nextChunk.fetch_add(WORD_CHUNK))
+                    {
+                        const std::size_t end = std::min(begin + WORD_CHUNK, words);
+                        for (std::size_t w = begin; w < end; ++w)
+                        {
+                            std::uint64_t bits = 0;
+                            const int first = static_cast<int>(w * 64);
+                            const int last = std::min(n, first + 64);
+                            for (int v = first; v < last; ++v)
+                            {
+                                if (level[v].load(std::memory_order_relaxed) >= 0)
+                                    continue;
+                                const int degree = graph.inDegree(v);
+                                for (int k = 0; k < degree; ++k)
+                                {
+                                    const int u = graph.inSource(v, k);
+                                    if ((current[u >> 6] >> (u & 63)) & 1)
+                                    {
+                                        level[v].store(nextLevel, std::memory_order_relaxed);
+                                        bits |= std::uint64_t(1) << (v & 63);
+                                        ++count;
+                                        outEdges += graph.outDegree(v);
+                                        inEdges += degree;
+                                        break;
+                                    }
+                                }
+                            }
+                            next[w] = bits;
+                        }
+                    }
+                    found += count;
+                    foundOutEdges += outEdges;
+                    foundInEdges += inEdges;
+                });
+                current.swap(next);
+                if (stats)
+                    ++stats->bottomUpSteps;
+            }
+            else
+            {
+                pool.run([&](int tid) {
+                    auto& out = local[tid];
+                    out.clear();
+                    long long outEdges = 0, inEdges = 0;
+                    for (std::size_t begin = nextChunk.fetch_add(QUEUE_CHUNK); begin < queue.size();
+                         begin = nextChunk.fetch_add(QUEUE_CHUNK))
+                    {
+                        const std::size_t end = std::min(begin + QUEUE_CHUNK, queue.size());
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            const int u = queue[i];
+                            const int degree = graph.outDegree(u);
+                            for (int k = 0; k < degree; ++k)
+                            {
+                                const int v = graph.outTarget(u, k);
+                                int expected = -1;
+                                if (level[v].load(std::memory_order_relaxed) < 0
+                                    && level[v].compare_exchange_strong(expected, nextLevel,
+                                                                        std::memory_order_relaxed))
+                                {
+                                    out.push_back(v);
+                                    outEdges += graph.outDegree(v);
+                                    inEdges += graph.inDegree(v);
+                                }
+                            }
+                        }
+                    }
+                    found += static_cast<long long>(out.size());
+                    foundOutEdges += outEdges;
+                    foundInEdges += inEdges;
+                });
+                queue.clear();
+                for (auto& list : local)
+                    queue.insert(queue.end(), list.begin(), list.end());
+                if (stats)
+                    ++stats->topDownSteps;
+            }
+
+            frontierSize = found.load();
+            frontierEdges = foundOutEdges.load();
+            unexploredEdges -= foundInEdges.load();
+        }
+    }
+};
+
+#endif // PARALLEL_BFS_H
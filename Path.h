@@ -1,6 +1,8 @@
 #ifndef LAB4_PATH
 #define LAB4_PATH
 #include "DynamicArray.h"
+#include <span>
+#include <utility>
 
 template<typename T>
 class Path
@@ -10,23 +12,57 @@ private:
     DynamicArray<T> path;
 public:
     Path() = default;
-    
-    Path(DynamicArray<int>& distances_, DynamicArray<T>& path_)
+
+    // Массивы забираются перемещением: Path(std::move(d), std::move(p))
+    Path(DynamicArray<int> distances_, DynamicArray<T> path_)
+        : distances(std::move(distances_)), path(std::move(path_))
     {
-        distances = distances_;
-        path = path_;
     }
-    
-    DynamicArray<int> GetDistances()
+
+    // Доступ без копирования
+    const DynamicArray<int>& GetDistances() const &
     {
         return distances;
     }
-    
-    DynamicArray<T> GetPath()
+
+    const DynamicArray<T>& GetPath() const &
     {
         return path;
     }
+
+    // У временного Path массивы забираются, а не копируются
+    DynamicArray<int> GetDistances() &&
+    {
+        return std::move(distances);
+    }
+
+    DynamicArray<T> GetPath() &&
+    {
+        return std::move(path);
+    }
+
+    // Непрерывные представления
+    std::span<const int> DistancesView() const
+    {
+        return {distances.get_data(), distances.get_size()};
+    }
+
+    std::span<const T> PathView() const
+    {
+        return {path.get_data(), path.get_size()};
+    }
+
+    // Забрать массив из Path; сам Path после этого пуст
+    DynamicArray<int> TakeDistances()
+    {
+        return std::move(distances);
+    }
+
+    DynamicArray<T> TakePath()
+    {
+        return std::move(path);
+    }
 };
 
 
-#endif //LAB4_PATH
\ No newline at end of file
+#endif //LAB4_PATH
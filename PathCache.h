@@ -0,0 +1,137 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "ShortestPathTree.h"
+
+// Кэш деревьев кратчайших путей для повторяющихся запросов.
+// Ключ — индекс источника; дерево хранит полные dist/prev, поэтому
+// любой финиш из того же источника отвечается без поиска.
+// Всё содержимое привязано к версии графа: при первом обращении с
+// другой версией кэш очищается. Вытеснение — LRU, не больше capacity
+// деревьев. Не потокобезопасен (как и сам изменяемый Graph<T>).
+
+template<typename T>
+class ShortestPathCache
+{
+private:
+    using Entry = std::pair<int, ShortestPathTree<T>>;
+
+    std::size_t capacity = 0;
+    std::uint64_t version = 0;
+    std::list<Entry> entries;   // в начале — недавно использованные
+    std::unordered_map<int, typename std::list<Entry>::iterator> bySource;
+    long long hitCount = 0;
+    long long missCount = 0;
+
+    void sync(std::uint64_t graphVersion)
+    {
+        if (graphVersion != version)
+        {
+            clear();
+            version = graphVersion;
+        }
+    }
+
+public:
+    explicit ShortestPathCache(std::size_t maxTrees = 0)
+        : capacity(maxTrees)
+    {
+    }
+
+    // Деревья помнят адрес своего графа, а bySource — итераторы своего
+    // списка, поэтому копия или перенос кэша (вместе с Graph<T>) берёт
+    // только настройку capacity и начинается пустым
+    ShortestPathCache(const ShortestPathCache& other)
+        : capacity(other.capacity)
+    {
+    }
+
+    ShortestPathCache(ShortestPathCache&& other) noexcept
+        : capacity(other.capacity)
+    {
+        other.clear();
+    }
+
+    ShortestPathCache& operator=(const ShortestPathCache& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            capacity = other.capacity;
+        }
+        return *this;
+    }
+
+    ShortestPathCache& operator=(ShortestPathCache&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            capacity = other.capacity;
+            other.clear();
+        }
+        return *this;
+    }
+
+    bool enabled() const { return capacity > 0; }
+
+    void setCapacity(std::size_t maxTrees)
+    {
+        capacity = maxTrees;
+        while (entries.size() > capacity)
+        {
+            bySource.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    // nullptr — промах (счётчики обновляются)
+    const ShortestPathTree<T>* find(int source, std::uint64_t graphVersion)
+    {
+        sync(graphVersion);
+        auto it = bySource.find(source);
+        if (it == bySource.end())
+        {
+            ++missCount;
+            return nullptr;
+        }
+        ++hitCount;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    const ShortestPathTree<T>& insert(int source, std::uint64_t graphVersion, ShortestPathTree<T> tree)
+    {
+        sync(graphVersion);
+        auto it = bySource.find(source);
+        if (it != bySource.end())
+        {
+            entries.erase(it->second);
+            bySource.erase(it);
+        }
+        while (!entries.empty() && entries.size() >= capacity)
+        {
+            bySource.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(source, std::move(tree));
+        bySource[source] = entries.begin();
+        return entries.front().second;
+    }
+
+    void clear()
+    {
+        entries.clear();
+        bySource.clear();
+    }
+
+    std::size_t size() const { return entries.size(); }
+    long long hits() const { return hitCount; }
+    long long misses() const { return missCount; }
+};
+
+#endif // PATH_CACHE_H
@@ -0,0 +1,258 @@
+#ifndef PRIORITY_QUEUES_H
+#define PRIORITY_QUEUES_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+// Очереди с приоритетом для движков кратчайших путей.
+// Общий интерфейс (его и ждёт dijkstraSearch):
+//   push(v, key) — предложить вершине v ключ key;
+//   pop()        — извлечь пару (ключ, вершина) с минимальным ключом;
+//   empty(), clear().
+// Каждая очередь держит свой буфер между запросами, localQueue<Q>() —
+// готовые экземпляры на поток.
+
+// Счётчики операций — для сравнения очередей между собой
+struct HeapStats
+{
+    long long pushes = 0;
+    long long pops = 0;
+    long long decreases = 0;
+    std::size_t peakSize = 0;
+};
+
+// -----------------------------------------------------------------
+//  Двоичная куча с «ленивым» удалением: push всегда добавляет новую
+//  запись, устаревшие записи отбрасывает сам алгоритм при извлечении.
+//  Размер доходит до O(E).
+class LazyHeap
+{
+private:
+    std::vector<std::pair<double, int>> items;
+
+public:
+    HeapStats stats;
+
+    bool empty() const { return items.empty(); }
+    std::size_t size() const { return items.size(); }
+    void clear() { items.clear(); }
+
+    void push(int v, double key)
+    {
+        items.push_back({key, v});
+        std::push_heap(items.begin(), items.end(), std::greater<>());
+        ++stats.pushes;
+        stats.peakSize = std::max(stats.peakSize, items.size());
+    }
+
+    std::pair<double, int> pop()
+    {
+        std::pop_heap(items.begin(), items.end(), std::greater<>());
+        auto top = items.back();
+        items.pop_back();
+        ++stats.pops;
+        return top;
+    }
+};
+
+// -----------------------------------------------------------------
+//  Индексированная D-арная куча с decrease-key. Каждая вершина лежит
+//  в куче не более одного раза, pos[v] — её позиция (или -1), поэтому
+//  размер кучи не превышает V, а извлечённые записи всегда актуальны.
+//  D = 4 даёт неглубокое дерево и соседних детей в одной кэш-линии.
+template<int D = 4>
+class IndexedHeap
+{
+    static_assert(D >= 2, "IndexedHeap: арность должна быть не меньше 2");
+
+private:
+    std::vector<std::pair<double, int>> items; // (ключ, вершина)
+    std::vector<int> pos;                      // вершина -> позиция, -1 если нет
+
+    void place(std::size_t i, const std::pair<double, int>& item)
+    {
+        items[i] = item;
+        pos[item.second] = static_cast<int>(i);
+    }
+
+    void siftUp(std::size_t i)
+    {
+        auto item = items[i];
+        while (i > 0)
+        {
+            std::size_t parent = (i - 1) / D;
+            if (items[parent].first <= item.first)
+                break;
+            place(i, items[parent]);
+            i = parent;
+        }
+        place(i, item);
+    }
+
+    void siftDown(std::size_t i)
+    {
+        auto item = items[i];
+        const std::size_t n = items.size();
+        while (true)
+        {
+            std::size_t first = i * D + 1;
+            if (first >= n)
+                break;
+            std::size_t last = std::min(first + D, n);
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c)
+            {
+                if (items[c].first < items[best].first)
+                    best = c;
+            }
+            if (items[best].first >= item.first)
+                break;
+            place(i, items[best]);
+            i = best;
+        }
+        place(i, item);
+    }
+
+public:
+    HeapStats stats;
+
+    bool empty() const { return items.empty(); }
+    std::size_t size() const { return items.size(); }
+
+    bool contains(int v) const
+    {
+        return v < static_cast<int>(pos.size()) && pos[v] >= 0;
+    }
+
+    // Сбрасываем только оставшиеся записи: pos остаётся заполненным -1
+    void clear()
+    {
+        for (auto& item : items)
+            pos[item.second] = -1;
+        items.clear();
+    }
+
+    // Вставка или decrease-key; больший ключ игнорируется
+    void push(int v, double key)
+    {
+        if (v >= static_cast<int>(pos.size()))
+            pos.resize(v + 1, -1);
+
+        if (pos[v] >= 0)
+        {
+            std::size_t i = pos[v];
+            if (key < items[i].first)
+            {
+                items[i].first = key;
+                siftUp(i);
+                ++stats.decreases;
+            }
+            return;
+        }
+
+        items.push_back({key, v});
+        siftUp(items.size() - 1);
+        ++stats.pushes;
+        stats.peakSize = std::max(stats.peakSize, items.size());
+    }
+
+    std::pair<double, int> pop()
+    {
+        auto top = items.front();
+        pos[top.second] = -1;
+        auto last = items.back();
+        items.pop_back();
+        if (!items.empty())
+        {
+            items[0] = last;
+            siftDown(0);
+        }
+        ++stats.pops;
+        return top;
+    }
+};
+
+// -----------------------------------------------------------------
+//  Очередь Дейкстры–Дайала для целых неотрицательных весов не больше
+//  MAX_WEIGHT. Все ключи в очереди лежат в [current, current + span],
+//  поэтому хватает span + 1 корзин по кругу: push и pop — O(1)
+//  (плюс проход по пустым корзинам, суммарно не больше длины пути).
+//  Как и LazyHeap, устаревшие записи отбрасывает алгоритм.
+class BucketQueue
+{
+public:
+    // Веса из GUI — 1..100, из файлов input*.txt — тоже небольшие
+    static constexpr int MAX_WEIGHT = 255;
+
+    // Подходит ли вес ребра для этой очереди
+    static bool accepts(double weight)
+    {
+        return weight >= 0.0 && weight <= MAX_WEIGHT
+               && weight == static_cast<double>(static_cast<int>(weight));
+    }
+
+private:
+    std::vector<std::vector<int>> buckets;
+    long long current = 0;        // ключ корзины под «курсором»
+    std::size_t count = 0;
+
+public:
+    HeapStats stats;
+
+    explicit BucketQueue(int span = MAX_WEIGHT)
+        : buckets(span + 1)
+    {
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    void clear()
+    {
+        for (auto& bucket : buckets)
+            bucket.clear();
+        current = 0;
+        count = 0;
+    }
+
+    void push(int v, double key)
+    {
+        long long k = static_cast<long long>(key);
+        buckets[k % buckets.size()].push_back(v);
+        ++count;
+        ++stats.pushes;
+        stats.peakSize = std::max(stats.peakSize, count);
+    }
+
+    std::pair<double, int> pop()
+    {
+        std::size_t slot = current % buckets.size();
+        while (buckets[slot].empty())
+        {
+            ++current;
+            slot = current % buckets.size();
+        }
+        int v = buckets[slot].back();
+        buckets[slot].pop_back();
+        --count;
+        ++stats.pops;
+        return {static_cast<double>(current), v};
+    }
+};
+
+// -----------------------------------------------------------------
+//  Очереди текущего потока. Слотов два: двусторонним поискам нужна
+//  отдельная очередь на каждое направление.
+constexpr int LOCAL_QUEUE_SLOTS = 2;
+
+template<typename Queue>
+Queue& localQueue(int slot = 0)
+{
+    thread_local Queue queues[LOCAL_QUEUE_SLOTS];
+    return queues[slot];
+}
+
+#endif // PRIORITY_QUEUES_H
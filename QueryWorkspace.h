@@ -0,0 +1,113 @@
+#ifndef QUERY_WORKSPACE_H
+#define QUERY_WORKSPACE_H
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+// Плотное множество посещённых вершин: один бит на вершину.
+// Очистка — обнуление V / 64 слов, зато проверка соседа в обходе
+// читает в 64 раза меньше памяти, чем массив штампов.
+class VisitedBitset
+{
+private:
+    std::vector<std::uint64_t> words;
+
+public:
+    void reset(int vertexCount)
+    {
+        words.assign((static_cast<std::size_t>(vertexCount) + 63) / 64, 0);
+    }
+
+    bool test(int v) const { return (words[v >> 6] >> (v & 63)) & 1; }
+    void set(int v) { words[v >> 6] |= std::uint64_t(1) << (v & 63); }
+
+    // true, если вершина не была отмечена (и теперь отмечена)
+    bool insert(int v)
+    {
+        std::uint64_t bit = std::uint64_t(1) << (v & 63);
+        std::uint64_t& word = words[v >> 6];
+        if (word & bit)
+            return false;
+        word |= bit;
+        return true;
+    }
+};
+
+// Рабочая память для запросов (Дейкстра, DFS, BFS), одна на поток.
+// Массивы dist/prev не очищаются между запросами: у каждой ячейки есть
+// «штамп» поколения, и ячейка считается заполненной, только если её
+// штамп совпадает с текущим поколением. Поэтому reset() стоит O(1),
+// а переинициализируются лишь те вершины, которых запрос коснулся.
+// Буферы стека/очереди тоже переживают запрос вместе с ёмкостью
+// (очереди с приоритетом держат свои буферы сами, см. PriorityQueues.h).
+
+class QueryWorkspace
+{
+private:
+    std::vector<double> dist;
+    std::vector<int> prev;
+    std::vector<std::uint32_t> stamp;  // поколение, в котором ячейку трогали
+    std::uint32_t generation = 0;
+
+public:
+    // Буферы для движков: содержимое не определено между запросами
+    std::vector<int> order;            // очередь / порядок обхода
+    std::vector<std::pair<int, int>> frames; // стек DFS: (вершина, следующее ребро)
+    VisitedBitset seen;                // посещённые вершины для обходов (Traversal.h)
+
+    QueryWorkspace() = default;
+
+    // Начать новый запрос на графе из vertexCount вершин
+    void reset(int vertexCount)
+    {
+        if (static_cast<int>(stamp.size()) < vertexCount)
+        {
+            dist.resize(vertexCount);
+            prev.resize(vertexCount);
+            stamp.resize(vertexCount, 0);
+        }
+        if (++generation == 0)
+        {
+            // Счётчик переполнился — раз в 2^32 запросов чистим штампы
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        order.clear();
+        frames.clear();
+    }
+
+    // -- Метки вершин --
+    bool touched(int v) const { return stamp[v] == generation; }
+
+    double distance(int v) const
+    {
+        return touched(v) ? dist[v] : std::numeric_limits<double>::infinity();
+    }
+
+    int parent(int v) const { return touched(v) ? prev[v] : -1; }
+
+    void setLabel(int v, double d, int p)
+    {
+        stamp[v] = generation;
+        dist[v] = d;
+        prev[v] = p;
+    }
+
+    // Для обходов метка означает «вершина посещена»
+    bool visited(int v) const { return touched(v); }
+    void markVisited(int v) { setLabel(v, 0.0, -1); }
+
+    // Рабочая память текущего потока; слот 1 — для второго направления
+    // двусторонних поисков
+    static QueryWorkspace& local(int slot = 0)
+    {
+        thread_local QueryWorkspace workspaces[2];
+        return workspaces[slot];
+    }
+};
+
+#endif // QUERY_WORKSPACE_H
@@ -0,0 +1,229 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <memory>
+#include <vector>
+#include <limits>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include "Path.h"
+#include "DynamicArray.h"
+
+template<typename T>
+class Graph;
+
+template<typename T>
+class DynamicShortestPaths;
+
+template<typename T>
+class ShortestPathTree;
+
+// Номера версий графов: общий счётчик на процесс, поэтому одинаковая
+// версия у двух графов бывает, только если один — копия другого без
+// правок после копирования (то есть у них одинаковые вершины и рёбра)
+inline std::uint64_t nextGraphVersion()
+{
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
+// Признак жизни объекта графа: дерево держит weak_ptr и узнаёт, что
+// граф уничтожен. У копии (и у нового объекта при переносе) — свой
+// признак, присваивание оставляет объекту его собственный
+class GraphLifetime
+{
+private:
+    std::shared_ptr<const char> alive = std::make_shared<const char>(0);
+
+public:
+    GraphLifetime() = default;
+    GraphLifetime(const GraphLifetime&) {}
+    GraphLifetime& operator=(const GraphLifetime&) { return *this; }
+
+    std::weak_ptr<const void> watch() const { return alive; }
+};
+
+template<typename T, typename G>
+Path<T> makeTreePath(const G& graph, int finish, const ShortestPathTree<T>& tree);
+
+template<typename T>
+Path<T> makeMissingTreePath(const ShortestPathTree<T>& tree);
+
+// Дерево кратчайших путей из одного поиска: плотные массивы точных
+// (double) расстояний и предков по индексам вершин графа.
+// Маршруты не строятся заранее: routeFrom(v) — обход от v к источнику
+// по предкам без выделения памяти, pathTo/route собирают путь только
+// по запросу. Так один поиск отвечает на вопросы «путь до каждой вершины».
+// Дерево ссылается на граф (имена вершин) и годится, пока граф жив
+// и не правился: иначе сборка путей по именам бросает исключение.
+
+template<typename T>
+class ShortestPathTree
+{
+private:
+    const Graph<T>* graph = nullptr;
+    std::weak_ptr<const void> graphAlive;
+    std::uint64_t version = 0;
+    int sourceIndex = -1;
+    std::vector<double> dist;   // бесконечность — недостижима
+    std::vector<int> prev;      // -1 у источника и недостижимых
+
+    template<typename> friend class DynamicShortestPaths;
+
+    const Graph<T>& owner() const
+    {
+        if (!graph || graphAlive.expired())
+            throw std::runtime_error("Дерево кратчайших путей устарело: графа больше нет.");
+        if (graph->version() != version || graph->vertexCount() != vertexCount())
+            throw std::runtime_error("Дерево кратчайших путей устарело: граф изменился.");
+        return *graph;
+    }
+
+public:
+    ShortestPathTree() = default;
+
+    ShortestPathTree(const Graph<T>& g, int source, std::vector<double> distances,
+                     std::vector<int> parents)
+        : graph(&g), graphAlive(g.lifetime()), version(g.version()), sourceIndex(source),
+          dist(std::move(distances)), prev(std::move(parents))
+    {
+    }
+
+    // -- Плотные массивы --
+    int source() const { return sourceIndex; }
+    int vertexCount() const { return static_cast<int>(dist.size()); }
+    const std::vector<double>& distances() const { return dist; }
+    const std::vector<int>& parents() const { return prev; }
+
+    double distance(int v) const { return dist[v]; }
+    int parent(int v) const { return prev[v]; }
+    bool reachable(int v) const { return dist[v] != std::numeric_limits<double>::infinity(); }
+
+    // -- Путь от вершины к источнику без выделения памяти --
+    // for (int v : tree.routeFrom(target)) — target, предок, ..., источник
+    class RouteIterator
+    {
+    private:
+        const std::vector<int>* prev = nullptr;
+        int current = -1;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        RouteIterator() = default;
+        RouteIterator(const std::vector<int>* parents, int v)
+            : prev(parents), current(v)
+        {
+        }
+
+        int operator*() const { return current; }
+        RouteIterator& operator++()
+        {
+            current = (*prev)[current];
+            return *this;
+        }
+        RouteIterator operator++(int)
+        {
+            RouteIterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const RouteIterator& other) const { return current == other.current; }
+        bool operator!=(const RouteIterator& other) const { return current != other.current; }
+    };
+
+    struct RouteRange
+    {
+        RouteIterator first;
+        RouteIterator begin() const { return first; }
+        RouteIterator end() const { return RouteIterator(nullptr, -1); }
+    };
+
+    // Пусто, если target недостижима
+    RouteRange routeFrom(int target) const
+    {
+        return RouteRange{RouteIterator(&prev, reachable(target) ? target : -1)};
+    }
+
+    // Индексы вершин пути источник -> target (пусто, если пути нет)
+    std::vector<int> route(int target) const
+    {
+        std::vector<int> result;
+        for (int v : routeFrom(target))
+            result.push_back(v);
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    // -- По именам --
+    double distanceTo(const T& name) const
+    {
+        int v = owner().indexOf(name);
+        return v < 0 ? std::numeric_limits<double>::infinity() : dist[v];
+    }
+
+    // Тот же формат, что у Graph<T>::dijkstraPath; расстояния точны
+    // для всех вершин, а не только до финиша
+    Path<T> pathTo(const T& finishName) const
+    {
+        const Graph<T>& g = owner();
+        const int finish = g.indexOf(finishName);
+        if (finish < 0)
+            return makeMissingTreePath<T>(*this);
+        return makeTreePath<T>(g, finish, *this);
+    }
+};
+
+// Path<T> из дерева: расстояния до всех вершин (точные — поиск был
+// полным), путь source -> finish по предкам. Имена берутся из graph:
+// так дерево из кэша годится и для копии графа.
+template<typename T, typename G>
+Path<T> makeTreePath(const G& graph, int finish, const ShortestPathTree<T>& tree)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+
+    const int n = graph.vertexCount();
+    if (n != tree.vertexCount())
+        throw std::runtime_error("Дерево кратчайших путей построено для другого графа.");
+    for (int i = 0; i < n; ++i)
+    {
+        double d = tree.distance(i);
+        distArr.push_back(d == INF ? -1 : static_cast<int>(d));
+    }
+
+    if (!tree.reachable(finish))
+        return Path<T>(std::move(distArr), std::move(pathArr));
+
+    auto route = tree.routeFrom(finish);
+    auto length = std::distance(route.begin(), route.end());
+
+    pathArr = DynamicArray<T>(static_cast<std::size_t>(length));
+    auto pos = length - 1;
+    for (int v : route)
+        pathArr[pos--] = graph.vertexName(v);
+
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+// Нет такой вершины-финиша: расстояния есть, пути нет
+template<typename T>
+Path<T> makeMissingTreePath(const ShortestPathTree<T>& tree)
+{
+    DynamicArray<int> distArr;
+    DynamicArray<T> pathArr;
+    for (int v = 0; v < tree.vertexCount(); ++v)
+        distArr.push_back(tree.reachable(v) ? static_cast<int>(tree.distance(v)) : -1);
+    return Path<T>(std::move(distArr), std::move(pathArr));
+}
+
+#endif // SHORTEST_PATH_TREE_H
@@ -2,7 +2,23 @@
 #define LAB4_TESTS
 
 #include "Graph.h"      // Ваш класс Graph
+#include "Landmarks.h"
+#include "ContractionHierarchy.h"
+#include "DeltaStepping.h"
+#include "AllPairs.h"
+#include "DynamicShortestPaths.h"
+#include "ParallelBfs.h"
+#include "MultiSourceBfs.h"
 #include <cassert>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <ranges>
 
 // Пример теста, проверяющего алгоритм Дейкстры
 void TestDijkstra() {
@@ -84,4 +100,1579 @@ void TestDijkstra() {
     }
 }
 
+// CSR-снимок должен отвечать так же, как исходный граф
+void TestCsrGraph() {
+    Graph<std::string> graph;
+    graph.addVertex("a");
+    graph.addVertex("b");
+    graph.addVertex("c");
+    graph.addVertex("d");
+
+    graph.addEdge("a", "b", 1);
+    graph.addEdge("a", "c", 4);
+    graph.addEdge("b", "c", 2);
+    graph.addEdge("c", "d", 1);
+
+    CsrGraph<std::string> csr = graph.freeze();
+    assert(csr.vertexCount() == 4);
+    assert(csr.edgeCount() == 4);
+    assert(csr.outDegree(csr.indexOf("a")) == 2);
+    assert(csr.inDegree(csr.indexOf("c")) == 2);
+
+    // --- Дейкстра: a -> b -> c -> d, длина 4 ---
+    {
+        auto result = csr.dijkstraPath("a", "d");
+        auto dist = result.GetDistances();
+        auto path = result.GetPath();
+
+        assert(dist[3] == 4);
+        assert(path.get_size() == 4);
+        assert(path[0] == "a");
+        assert(path[3] == "d");
+    }
+
+    // --- Обходы ---
+    {
+        auto names = [&csr](const TraversalResult& result) {
+            std::vector<std::string> order;
+            for (int v : result.order)
+                order.push_back(csr.vertexName(v));
+            return order;
+        };
+        TraversalOptions full{true, true};
+
+        TraversalResult dfs = csr.depthFirstSearch("a", full);
+        assert((names(dfs) == std::vector<std::string>{"a", "b", "c", "d"}));
+        assert(dfs.order == graph.depthFirstSearch("a").order);
+        assert(dfs.depth[csr.indexOf("d")] == 3);
+
+        TraversalResult bfs = csr.breadthFirstSearch("a", full);
+        assert((names(bfs) == std::vector<std::string>{"a", "b", "c", "d"}));
+        assert(bfs.parent[csr.indexOf("c")] == csr.indexOf("a"));
+        assert(csr.breadthFirstSearch("x").empty());
+    }
+
+    // --- После правки снимок пересобирается ---
+    graph.removeVertex("b");
+    csr = graph.freeze();
+    assert(csr.vertexCount() == 3);
+    assert(csr.dijkstraPath("a", "d").GetDistances()[2] == 5);
+
+    // --- removeEdge не трогает общий список рёбер: снимок, удаление
+    //     вершины и новые рёбра после него видят актуальный граф ---
+    graph.addEdge("a", "d", 9);
+    graph.removeEdge("c", "d");
+    graph.addEdge("d", "a", 1);
+    csr = graph.freeze();
+    assert(csr.edgeCount() == 3);
+    assert(csr.dijkstraPath("a", "d").GetDistances()[2] == 9);
+    graph.removeVertex("c");
+    csr = graph.freeze();
+    assert(csr.vertexCount() == 2);
+    assert(csr.edgeCount() == 2);
+    assert(csr.outDegree(csr.indexOf("d")) == 1);
+    assert(csr.dijkstraPath("a", "d").GetDistances()[1] == 9);
+}
+
+// Одна рабочая память на много запросов: метки прошлых запросов
+// не должны просачиваться в следующие
+void TestQueryWorkspace() {
+    Graph<int> graph;
+    for (int i = 0; i < 4; ++i)
+        graph.addVertex(i);
+    graph.addEdge(0, 1, 2);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(3, 2, 1);
+
+    QueryWorkspace ws;
+    for (int round = 0; round < 3; ++round)
+    {
+        auto full = graph.dijkstraPath(0, 2, ws);
+        assert(full.GetDistances()[2] == 4);
+        assert(full.GetPath().get_size() == 3);
+
+        // Из 3 вершины 0 и 1 недостижимы, хотя прошлый запрос их заполнил
+        auto other = graph.dijkstraPath(3, 2, ws);
+        assert(other.GetDistances()[0] == -1);
+        assert(other.GetDistances()[1] == -1);
+        assert(other.GetDistances()[2] == 1);
+
+        auto none = graph.dijkstraPath(2, 0, ws);
+        assert(none.GetPath().get_size() == 0);
+    }
+}
+
+// Индексированная куча: порядок извлечения, decrease-key
+// и те же расстояния в Дейкстре, что и с ленивой кучей
+void TestIndexedHeap() {
+    {
+        IndexedHeap<4> heap;
+        heap.push(5, 3.0);
+        heap.push(1, 7.0);
+        heap.push(2, 1.0);
+        heap.push(1, 0.5);  // decrease-key
+        heap.push(2, 9.0);  // больший ключ игнорируется
+        assert(heap.size() == 3);
+        assert(heap.stats.decreases == 1);
+
+        assert(heap.pop().second == 1);
+        assert(heap.pop().second == 2);
+        assert(heap.pop().second == 5);
+        assert(heap.empty());
+        assert(!heap.contains(5));
+    }
+
+    Graph<int> graph;
+    for (int i = 0; i < 6; ++i)
+        graph.addVertex(i);
+    graph.addEdge(0, 1, 7);
+    graph.addEdge(0, 2, 9);
+    graph.addEdge(0, 5, 14);
+    graph.addEdge(1, 2, 10);
+    graph.addEdge(1, 3, 15);
+    graph.addEdge(2, 3, 11);
+    graph.addEdge(2, 5, 2);
+    graph.addEdge(3, 4, 6);
+    graph.addEdge(5, 4, 9);
+
+    QueryWorkspace lazyWs, indexedWs;
+    IndexedHeap<4> heap;
+    dijkstraSearch<LazyHeap>(graph, 0, -1, lazyWs);
+    dijkstraSearch(graph, 0, -1, indexedWs, heap);
+    for (int v = 0; v < 6; ++v)
+        assert(lazyWs.distance(v) == indexedWs.distance(v));
+    assert(indexedWs.distance(4) == 20);
+    assert(heap.stats.peakSize <= 6);
+}
+
+// Корзины Дайала включаются сами, пока все веса — небольшие целые
+void TestBucketQueue() {
+    Graph<int> graph;
+    for (int i = 0; i < 5; ++i)
+        graph.addVertex(i);
+    graph.addEdge(0, 1, 4);
+    graph.addEdge(0, 2, 1);
+    graph.addEdge(2, 1, 2);
+    graph.addEdge(1, 3, 0);   // нулевой вес тоже допустим
+    graph.addEdge(3, 4, 255);
+    graph.addEdge(2, 4, 255);
+    assert(graph.hasSmallIntWeights());
+
+    QueryWorkspace bucketWs, heapWs;
+    BucketQueue queue;
+    dijkstraSearch(graph, 0, -1, bucketWs, queue);
+    dijkstraSearch<LazyHeap>(graph, 0, -1, heapWs);
+    for (int v = 0; v < 5; ++v)
+        assert(bucketWs.distance(v) == heapWs.distance(v));
+    assert(bucketWs.distance(3) == 3);
+    assert(bucketWs.distance(4) == 256);
+
+    auto path = graph.dijkstraPath(0, 3).GetPath();
+    assert(path.get_size() == 4);
+    assert(path[1] == 2);
+
+    // Дробный вес выключает корзины, удаление ребра — включает обратно
+    graph.addEdge(4, 0, 0.5);
+    assert(!graph.hasSmallIntWeights());
+    assert(!graph.freeze().hasSmallIntWeights());
+    graph.removeEdge(4, 0);
+    assert(graph.hasSmallIntWeights());
+
+    graph.addEdge(4, 0, 1000);
+    assert(!graph.hasSmallIntWeights());
+    graph.removeVertex(4);
+    assert(graph.hasSmallIntWeights());
+}
+
+// Двусторонний поиск должен находить те же длины, что и обычный
+void TestBidirectionalDijkstra() {
+    Graph<int> graph;
+    for (int i = 0; i < 7; ++i)
+        graph.addVertex(i);
+    graph.addEdge(0, 1, 2.5);
+    graph.addEdge(1, 2, 2.5);
+    graph.addEdge(2, 3, 2.5);
+    graph.addEdge(0, 4, 1.5);
+    graph.addEdge(4, 5, 1.5);
+    graph.addEdge(5, 3, 1.5);
+    graph.addEdge(3, 0, 1);
+
+    {
+        auto result = graph.bidirectionalDijkstraPath(0, 3);
+        auto path = result.GetPath();
+        assert(path.get_size() == 4);
+        assert(path[0] == 0);
+        assert(path[1] == 4);
+        assert(path[2] == 5);
+        assert(path[3] == 3);
+        assert(result.GetDistances()[3] == 4);
+    }
+
+    // Старт совпадает с финишем, финиш недостижим, вершины нет
+    assert(graph.bidirectionalDijkstraPath(2, 2).GetPath().get_size() == 1);
+    assert(graph.bidirectionalDijkstraPath(0, 6).GetPath().get_size() == 0);
+    assert(graph.bidirectionalDijkstraPath(0, 42).GetDistances()[0] == -1);
+
+    // Сверяем все пары с обычной Дейкстрой: на дробных весах поиск идёт
+    // на куче, на целых до BucketQueue::MAX_WEIGHT — на корзинах
+    auto compare = [](Graph<int>& g, bool buckets) {
+        CsrGraph<int> csr = g.freeze();
+        assert(csr.hasSmallIntWeights() == buckets);
+        for (int s = 0; s < 7; ++s)
+        {
+            for (int f = 0; f < 7; ++f)
+            {
+                auto one = g.dijkstraPath(s, f);
+                auto two = csr.bidirectionalDijkstraPath(s, f);
+                assert(one.GetPath().get_size() == two.GetPath().get_size());
+                if (one.GetPath().get_size() > 0)
+                    assert(one.GetDistances()[f] == two.GetDistances()[f]);
+            }
+        }
+    };
+
+    Graph<int> integral;
+    for (int i = 0; i < 7; ++i)
+        integral.addVertex(i);
+    integral.addEdge(0, 1, 3);
+    integral.addEdge(1, 2, 2);
+    integral.addEdge(2, 3, 3);
+    integral.addEdge(0, 4, 1);
+    integral.addEdge(4, 5, 2);
+    integral.addEdge(5, 3, 255);
+    integral.addEdge(3, 0, 1);
+
+    for (int round = 0; round < 2; ++round)
+    {
+        compare(graph, false);
+        compare(integral, true);
+        for (Graph<int>* g : {&graph, &integral})
+        {
+            g->addEdge(6, 2, 1);
+            g->addEdge(1, 6, 1);
+        }
+    }
+}
+
+// A* на решётке: те же длины, что у Дейкстры; без координат — откат
+void TestAStar() {
+    const int side = 6;
+    Graph<int> graph;
+    for (int i = 0; i < side * side; ++i)
+        graph.addVertex(i);
+
+    // Без координат aStarPath — это обычная Дейкстра
+    graph.addEdge(0, 1, 3);
+    assert(!graph.hasPositions());
+    assert(graph.aStarPath(0, 1).GetDistances()[1] == 3);
+    graph.removeEdge(0, 1);
+
+    for (int i = 0; i < side * side; ++i)
+        graph.setVertexPosition(i, (i % side) * 10.0, (i / side) * 10.0);
+    assert(graph.hasPositions());
+
+    // Вправо и вниз по решётке; вес не меньше длины ребра
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+                graph.addEdge(v, v + 1, 10 + (v % 3) * 5);
+            if (r + 1 < side)
+                graph.addEdge(v, v + side, 10 + (v % 4) * 5);
+        }
+    }
+
+    for (int target = 0; target < side * side; ++target)
+    {
+        auto fast = graph.aStarPath(0, target);
+        auto slow = graph.dijkstraPath(0, target);
+        assert(fast.GetDistances()[target] == slow.GetDistances()[target]);
+        assert(fast.GetPath().get_size() == slow.GetPath().get_size());
+    }
+
+    // Назад по решётке пути нет
+    assert(graph.aStarPath(side * side - 1, 0).GetPath().get_size() == 0);
+}
+
+// ALT: те же длины, что у Дейкстры, и до, и после сохранения в файл
+void TestLandmarks() {
+    Graph<int> graph;
+    const int n = 30;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < n; ++i)
+    {
+        graph.addEdge(i, (i + 1) % n, 1 + i % 5);
+        graph.addEdge(i, (i * 7 + 3) % n, 4 + i % 3);
+    }
+    graph.addVertex(n);          // изолированная вершина
+
+    CsrGraph<int> csr = graph.freeze();
+    LandmarkIndex<int> index(csr, 4, 2);
+    assert(index.landmarkCount() == 4);
+
+    const char* fileName = "test_landmarks.alt";
+    index.save(fileName);
+    LandmarkIndex<int> loaded = LandmarkIndex<int>::load(fileName);
+    std::remove(fileName);
+    assert(loaded.landmarkVertices() == index.landmarkVertices());
+
+    for (int s = 0; s <= n; s += 3)
+    {
+        for (int f = 0; f <= n; ++f)
+        {
+            auto expected = csr.dijkstraPath(s, f);
+            auto fast = index.query(csr, s, f);
+            auto again = loaded.query(csr, s, f);
+            assert(fast.GetPath().get_size() == expected.GetPath().get_size());
+            assert(again.GetPath().get_size() == expected.GetPath().get_size());
+            if (expected.GetPath().get_size() > 0)
+            {
+                assert(fast.GetDistances()[f] == expected.GetDistances()[f]);
+                assert(again.GetDistances()[f] == expected.GetDistances()[f]);
+            }
+        }
+    }
+
+    // Испорченные файлы и чужой граф отвергаются
+    auto loadFails = [](const char* contents) {
+        const char* badFile = "test_landmarks_bad.alt";
+        {
+            std::ofstream out(badFile);
+            out << contents;
+        }
+        bool failed = false;
+        try
+        {
+            LandmarkIndex<int>::load(badFile);
+        }
+        catch (const std::runtime_error&)
+        {
+            failed = true;
+        }
+        std::remove(badFile);
+        return failed;
+    };
+    assert(loadFails("ALT 3 2 1\n7\n0 0\n1 1\n2 2\n"));   // опорная вне [0, n)
+    assert(loadFails("ALT 3 2 1\nx\n"));                     // не число
+    assert(loadFails("ALT 3 2 1\n0\n0 0\n1 1\n"));         // обрезан
+    assert(loadFails("ALT 3 2 1\n0\n0 0\n1 zz\n2 2\n"));  // мусор в таблице
+    assert(!loadFails("ALT 3 2 1\n0\n0 0\n1 inf\n2 2\n"));
+
+    Graph<int> other = graph;
+    other.addEdge(0, 5, 1);     // столько же вершин, другое число рёбер
+    bool rejected = false;
+    try
+    {
+        index.query(other.freeze(), 0, 5);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Отрицательные веса (и отрицательный цикл) — исключение, а не
+    // неверные длины или зависание
+    auto rejects = [](Graph<int>& g) {
+        CsrGraph<int> negative = g.freeze();
+        try
+        {
+            LandmarkIndex<int> bad(negative, 2, 1);
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+    Graph<int> negative;
+    for (int i = 0; i < 3; ++i)
+        negative.addVertex(i);
+    negative.addEdge(0, 1, 1);
+    negative.addEdge(0, 2, 10);
+    negative.addEdge(2, 1, -20);
+    assert(rejects(negative));
+    assert(negative.freeze().dijkstraPath(0, 1).GetDistances()[1] == -10);
+
+    Graph<int> cycle;
+    cycle.addVertex(0);
+    cycle.addVertex(1);
+    cycle.addEdge(0, 1, -3);
+    cycle.addEdge(1, 0, 0);
+    assert(rejects(cycle));
+
+    // Индекс с неотрицательного графа не применяется к графу с отрицательными весами
+    Graph<int> positive;
+    for (int i = 0; i < 3; ++i)
+        positive.addVertex(i);
+    positive.addEdge(0, 1, 1);
+    positive.addEdge(0, 2, 10);
+    positive.addEdge(2, 1, 20);
+    LandmarkIndex<int> positiveIndex(positive.freeze(), 2, 1);
+    bool thrown = false;
+    try
+    {
+        positiveIndex.query(negative.freeze(), 0, 1);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+// Иерархия сжатий: те же длины, путь из рёбер исходного графа
+void TestContractionHierarchy() {
+    Graph<int> graph;
+    const int side = 5;
+    for (int i = 0; i < side * side; ++i)
+        graph.addVertex(i);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+            {
+                graph.addEdge(v, v + 1, 1 + (v * 7) % 5);
+                graph.addEdge(v + 1, v, 1 + (v * 3) % 4);
+            }
+            if (r + 1 < side)
+            {
+                graph.addEdge(v, v + side, 2 + (v * 5) % 3);
+                graph.addEdge(v + side, v, 1 + v % 6);
+            }
+        }
+    }
+    graph.addVertex(side * side);  // изолированная вершина
+
+    CsrGraph<int> csr = graph.freeze();
+    ContractionHierarchy<int> ch(csr);
+
+    for (int s = 0; s <= side * side; ++s)
+    {
+        for (int f = 0; f <= side * side; ++f)
+        {
+            auto expected = csr.dijkstraPath(s, f);
+            auto result = ch.query(csr, s, f);
+            auto path = result.GetPath();
+            assert((path.get_size() > 0) == (expected.GetPath().get_size() > 0));
+            if (path.get_size() == 0)
+                continue;
+
+            assert(result.GetDistances()[f] == expected.GetDistances()[f]);
+            assert(path[0] == s);
+            assert(path[path.get_size() - 1] == f);
+
+            // Ярлыки развёрнуты: соседние вершины пути связаны ребром
+            for (size_t i = 0; i + 1 < path.get_size(); ++i)
+            {
+                bool found = false;
+                csr.forEachOut(path[i], [&](int v, double){
+                    if (v == path[i + 1])
+                        found = true;
+                });
+                assert(found);
+            }
+        }
+    }
+
+    // Ребро добавили после построения — иерархия отвергает новый снимок
+    graph.addEdge(0, side * side, 1);
+    bool rejected = false;
+    try
+    {
+        ch.query(graph.freeze(), 0, side * side);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+}
+
+void TestDeltaStepping() {
+    Graph<int> graph;
+    const int n = 60;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < n; ++i)
+    {
+        // Лёгкие и тяжёлые рёбра вперемешку, плюс недостижимый хвост
+        if (i + 1 < n - 5)
+            graph.addEdge(i, i + 1, 1 + (i * 7) % 3);
+        if (i + 7 < n - 5)
+            graph.addEdge(i, i + 7, 5 + (i * 11) % 40);
+        if (i >= 3 && i < n - 5)
+            graph.addEdge(i, i - 3, 2 + (i * 5) % 9);
+    }
+
+    CsrGraph<int> csr = graph.freeze();
+    ThreadPool single(1);
+    ThreadPool several(3);
+    for (double delta : {0.0, 1.0, 4.0, 100.0})
+    {
+        DeltaStepping<int> solver(csr, delta);
+        for (int s = 0; s < n; s += 7)
+        {
+            QueryWorkspace ws;
+            dijkstraSearch(csr, s, -1, ws);
+
+            DynamicArray<int> a = solver.distances(csr, s, single);
+            DynamicArray<int> b = solver.distances(csr, s, several);
+            assert(a.get_size() == static_cast<size_t>(n));
+            for (int v = 0; v < n; ++v)
+            {
+                int d = ws.touched(v) ? static_cast<int>(ws.distance(v)) : -1;
+                assert(a[v] == d);
+                assert(b[v] == d);
+            }
+        }
+    }
+
+    // Нет такой вершины — все -1
+    DeltaStepping<int> solver(csr);
+    DynamicArray<int> missing = solver.distances(csr, 1000, several);
+    for (int v = 0; v < n; ++v)
+        assert(missing[v] == -1);
+
+    // Решатель не держит ссылку на граф: временный снимок можно отпустить
+    DeltaStepping<int> detached(graph.freeze(), 2.0);
+    DynamicArray<int> fromTemporary = detached.distances(csr, 0, single);
+    DynamicArray<int> fromSolver = solver.distances(csr, 0, single);
+    for (int v = 0; v < n; ++v)
+        assert(fromTemporary[v] == fromSolver[v]);
+
+    auto throws = [](auto&& call) {
+        try
+        {
+            call();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    // Чужой граф и бесконечный вес — исключение
+    Graph<int> other = graph;
+    other.addEdge(0, n - 1, 1);
+    assert(throws([&]{ solver.distances(other.freeze(), 0, single); }));
+    Graph<int> infinite = graph;
+    infinite.addEdge(0, n - 1, std::numeric_limits<double>::infinity());
+    assert(throws([&]{ DeltaStepping<int> bad(infinite.freeze()); }));
+
+    // Огромный вес при узких корзинах: корзины расширяются, ответ точный
+    Graph<int> huge = graph;
+    huge.addEdge(n - 6, n - 1, 1e15);
+    CsrGraph<int> hugeCsr = huge.freeze();
+    DeltaStepping<int> wide(hugeCsr, 1.0);
+    assert(wide.bucketWidth() > 1.0);
+    std::vector<double> far = wide.run(0, several);
+    QueryWorkspace ws;
+    dijkstraSearch(hugeCsr, 0, -1, ws);
+    for (int v = 0; v < n; ++v)
+        assert(far[v] == (ws.touched(v) ? ws.distance(v) : std::numeric_limits<double>::infinity()));
+}
+
+void TestDistanceMatrix() {
+    Graph<std::string> graph;
+    for (const char* name : {"A", "B", "C", "D", "E"})
+        graph.addVertex(name);
+    graph.addEdge("A", "B", 2);
+    graph.addEdge("B", "C", 3);
+    graph.addEdge("A", "C", 10);
+    graph.addEdge("C", "D", 1);
+    graph.addEdge("D", "A", 4);
+    // E изолирована
+
+    std::vector<std::string> sources = {"A", "C", "E", "X"};
+    std::vector<std::string> targets = {"D", "A", "C", "A", "E"};
+    const double INF = std::numeric_limits<double>::infinity();
+    const double expected[4][5] = {
+        {6, 0, 5, 0, INF},
+        {1, 5, 0, 5, INF},
+        {INF, INF, INF, INF, 0},
+        {INF, INF, INF, INF, INF},
+    };
+
+    for (int threads : {1, 3})
+    {
+        DistanceMatrix m = graph.distanceMatrix(sources, targets, threads);
+        assert(m.rows() == 4 && m.columns() == 5);
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 5; ++c)
+                assert(m.at(r, c) == expected[r][c]);
+    }
+
+    // CSR-снимок и дробные веса (очередь-куча) дают то же самое
+    graph.addEdge("E", "D", 0.5);
+    DistanceMatrix m = graph.freeze().distanceMatrix(sources, targets, 2);
+    assert(m.at(2, 0) == 0.5);
+    assert(m.at(2, 1) == 4.5);
+    assert(m.row(0)[2] == 5);
+}
+
+void TestAllPairs() {
+    // 70 вершин — больше одного блока и с дополнением до кратного BLOCK
+    Graph<int> graph;
+    const int n = 70;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < n - 2; ++i)
+    {
+        graph.addEdge(i, (i * 13 + 5) % (n - 2), 1 + (i * 7) % 9);
+        graph.addEdge(i, (i + 1) % (n - 2), 3 + i % 4);
+        graph.addEdge(i, (i * 31 + 2) % (n - 2), 2 + (i * 3) % 11);
+    }
+    graph.addEdge(n - 2, 0, 1);  // n - 2 достигает всех, её не достигает никто
+                                 // n - 1 изолирована
+
+    for (int threads : {1, 3})
+    {
+        AllPairsShortestPaths<int> apsp(graph, threads);
+        for (int s = 0; s < n; ++s)
+        {
+            QueryWorkspace ws;
+            dijkstraSearch(graph, s, -1, ws);
+            for (int f = 0; f < n; ++f)
+            {
+                assert(apsp.distance(s, f) == ws.distance(f));
+
+                // Путь по next-hop идёт по рёбрам и даёт ту же длину
+                std::vector<int> route = apsp.route(s, f);
+                assert(route.empty() == (ws.distance(f) == std::numeric_limits<double>::infinity()));
+                if (route.empty())
+                    continue;
+                assert(route.front() == s && route.back() == f);
+                double length = 0.0;
+                for (size_t i = 0; i + 1 < route.size(); ++i)
+                {
+                    double best = std::numeric_limits<double>::infinity();
+                    graph.forEachOut(route[i], [&](int v, double w){
+                        if (v == route[i + 1] && w < best)
+                            best = w;
+                    });
+                    length += best;
+                }
+                assert(length == apsp.distance(s, f));
+            }
+        }
+
+        // Path<T>: до финиша — как у dijkstraPath, строка расстояний полная
+        auto p = apsp.path(n - 2, 5);
+        assert(p.GetDistances()[5] == graph.dijkstraPath(n - 2, 5).GetDistances()[5]);
+        assert(p.GetDistances()[n - 1] == -1);
+        for (int v = 0; v + 1 < n; ++v)
+            assert(p.GetDistances()[v] == static_cast<int>(apsp.distance(n - 2, v)));
+        assert(p.GetPath()[0] == n - 2);
+        assert(p.GetPath()[p.GetPath().get_size() - 1] == 5);
+    }
+
+    // Отрицательные рёбра без отрицательных циклов
+    Graph<std::string> small;
+    for (const char* name : {"A", "B", "C"})
+        small.addVertex(name);
+    small.addEdge("A", "B", 4);
+    small.addEdge("A", "C", 1);
+    small.addEdge("C", "B", -2);
+    AllPairsShortestPaths<std::string> signedPaths(small);
+    assert(signedPaths.distance(0, 1) == -1);
+    assert(signedPaths.route(0, 1) == std::vector<int>({0, 2, 1}));
+
+    // Выгрузка в формате input.txt
+    const char* fileName = "apsp_test.txt";
+    signedPaths.save(fileName);
+    std::ifstream in(fileName);
+    std::string line;
+    std::getline(in, line);
+    assert(line == "A,B,C");
+    std::vector<std::string> rows;
+    while (std::getline(in, line))
+        rows.push_back(line);
+    assert(rows == std::vector<std::string>({"A,B,-1", "A,C,1", "C,B,-2"}));
+    in.close();
+    std::remove(fileName);
+
+    // Дробное расстояние загрузчик (веса — int) не прочтёт: исключение,
+    // файл не создаётся
+    Graph<std::string> fractional = small;
+    fractional.addEdge("A", "B", 2.5);
+    fractional.removeEdge("A", "C");
+    AllPairsShortestPaths<std::string> halves(fractional);
+    bool rejected = false;
+    try
+    {
+        halves.save(fileName);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    assert(rejected && !std::ifstream(fileName));
+
+    small.addEdge("B", "A", 1);  // цикл A -> C -> B -> A веса 0 — допустим
+    AllPairsShortestPaths<std::string> zeroCycle(small);
+    small.addEdge("B", "C", 0);  // C -> B -> C веса -2
+    bool thrown = false;
+    try
+    {
+        AllPairsShortestPaths<std::string> broken(small);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void TestNegativeWeights() {
+    // Веса base + p(u) - p(v) при base >= 0: отрицательные рёбра есть,
+    // отрицательных циклов нет
+    Graph<int> graph;
+    const int n = 40;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    auto potential = [](int v) { return (v * 37) % 23; };
+    for (int u = 0; u < n; ++u)
+    {
+        for (int v : {(u + 1) % n, (u * 7 + 3) % n, (u * 11 + 5) % n})
+        {
+            if (v != u)
+                graph.addEdge(u, v, (u + v) % 4 + potential(u) - potential(v));
+        }
+    }
+    assert(graph.hasNegativeWeights());
+
+    AllPairsShortestPaths<int> exact(graph);
+    CsrGraph<int> csr = graph.freeze();
+    assert(csr.hasNegativeWeights());
+    for (int s = 0; s < n; s += 3)
+    {
+        for (int f = 0; f < n; ++f)
+        {
+            int expected = static_cast<int>(exact.distance(s, f));
+            auto johnson = graph.dijkstraPath(s, f);
+            auto bellmanFord = graph.bellmanFordPath(s, f);
+            assert(johnson.GetDistances()[f] == expected);
+            assert(bellmanFord.GetDistances()[f] == expected);
+            assert(csr.dijkstraPath(s, f).GetDistances()[f] == expected);
+            assert(graph.bidirectionalDijkstraPath(s, f).GetDistances()[f] == expected);
+
+            auto path = johnson.GetPath();
+            assert(path[0] == s && path[path.get_size() - 1] == f);
+        }
+    }
+
+    std::vector<int> all;
+    for (int i = 0; i < n; ++i)
+        all.push_back(i);
+    DistanceMatrix m = graph.distanceMatrix(all, all, 2);
+    DistanceMatrix mc = csr.distanceMatrix(all, all, 2);
+    for (int s = 0; s < n; ++s)
+        for (int f = 0; f < n; ++f)
+            assert(m.at(s, f) == exact.distance(s, f) && mc.at(s, f) == exact.distance(s, f));
+
+    // Свободная distanceMatrix по индексам тоже учитывает отрицательные веса
+    DistanceMatrix byIndex = distanceMatrix(csr, all, all, 2);
+    DistanceMatrix freeGraph = distanceMatrix(graph, all, all, 1);
+    assert(byIndex.data() == mc.data() && freeGraph.data() == m.data());
+
+    // Удаление неотрицательного ребра не сбрасывает потенциалы, но
+    // ответы остаются точными
+    Graph<int> pruned = graph;
+    pruned.distanceMatrix(all, all, 1);
+    for (int u = 0; u < n; ++u)
+    {
+        int target = -1;
+        pruned.forEachOut(u, [&](int v, double w){
+            if (w >= 0.0 && target < 0)
+                target = v;
+        });
+        if (target >= 0)
+            pruned.removeEdge(u, target);
+    }
+    assert(pruned.hasNegativeWeights());
+    DistanceMatrix afterRemoval = pruned.distanceMatrix(all, all, 2);
+    assert(afterRemoval.data() == distanceMatrix(pruned.freeze(), all, all, 1).data());
+
+    // Отрицательный цикл 0 -> 1 -> 0
+    Graph<int> cyclic;
+    for (int i = 0; i < 3; ++i)
+        cyclic.addVertex(i);
+    cyclic.addEdge(0, 1, 2);
+    cyclic.addEdge(1, 2, 1);
+    cyclic.addEdge(1, 0, -3);
+    auto throws = [](auto&& query) {
+        try
+        {
+            query();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([&]{ cyclic.dijkstraPath(0, 2); }));
+    assert(throws([&]{ cyclic.bellmanFordPath(0, 2); }));
+    assert(throws([&]{ cyclic.freeze().dijkstraPath(0, 2); }));
+    assert(throws([&]{ distanceMatrix(cyclic, {0}, {2}); }));
+    assert(throws([&]{ distanceMatrix(cyclic.freeze(), {0}, {2}); }));
+    assert(throws([&]{ cyclic.distanceMatrix({0}, {2}); }));
+
+    // Ребро убрали — флаг и потенциалы обновились
+    cyclic.removeEdge(1, 0);
+    assert(!cyclic.hasNegativeWeights());
+    assert(cyclic.dijkstraPath(0, 2).GetDistances()[2] == 3);
+    cyclic.addEdge(2, 0, -3);  // цикл 0 -> 1 -> 2 -> 0 веса 0
+    assert(cyclic.dijkstraPath(1, 0).GetDistances()[0] == -2);
+}
+
+void TestKShortestPaths() {
+    Graph<int> graph;
+    const int n = 9;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int u = 0; u < n; ++u)
+    {
+        std::set<int> targets = {(u + 1) % n, (u + 2) % n, (u * 5 + 3) % n};
+        targets.erase(u);
+        for (int v : targets)
+            graph.addEdge(u, v, 1 + (u * 3 + v) % 5);
+    }
+
+    // Все простые пути 0 -> 7 перебором
+    const int start = 0;
+    const int finish = 7;
+    std::vector<int> expected;
+    std::vector<char> onPath(n, 0);
+    std::function<void(int, int)> enumerate = [&](int v, int length) {
+        if (v == finish)
+        {
+            expected.push_back(length);
+            return;
+        }
+        onPath[v] = 1;
+        graph.forEachOut(v, [&](int to, double w){
+            if (!onPath[to])
+                enumerate(to, length + static_cast<int>(w));
+        });
+        onPath[v] = 0;
+    };
+    enumerate(start, 0);
+    std::sort(expected.begin(), expected.end());
+
+    const int k = 40;
+    auto paths = graph.kShortestPaths(start, finish, k);
+    assert(paths.size() == std::min<size_t>(k, expected.size()));
+
+    std::set<std::vector<int>> distinct;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        auto route = paths[i].GetPath();
+        auto dist = paths[i].GetDistances();
+        assert(route[0] == start && route[route.get_size() - 1] == finish);
+        assert(dist[finish] == expected[i]);
+
+        std::vector<int> vertices;
+        for (size_t j = 0; j < route.get_size(); ++j)
+            vertices.push_back(route[j]);
+        std::vector<int> sorted = vertices;
+        std::sort(sorted.begin(), sorted.end());
+        assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());  // простой
+        distinct.insert(vertices);
+    }
+    assert(distinct.size() == paths.size());
+
+    // Путей меньше k — возвращаются все; нет вершины — пусто
+    assert(graph.kShortestPaths(start, finish, 1000).size() == expected.size());
+    assert(graph.kShortestPaths(start, 100, 3).empty());
+    assert(graph.freeze().kShortestPaths(start, finish, k).size() == paths.size());
+}
+
+void TestPathCache() {
+    Graph<int> graph;
+    auto v0 = graph.version();
+    for (int i = 0; i < 6; ++i)
+        graph.addVertex(i);
+    assert(graph.version() > v0);
+    for (int i = 0; i + 1 < 6; ++i)
+        graph.addEdge(i, i + 1, i + 1);
+    graph.addEdge(0, 5, 100);
+
+    Graph<int> reference = graph;  // тот же граф без кэша
+    graph.enablePathCache(2);
+
+    auto same = [&](int s, int f) {
+        auto a = graph.dijkstraPath(s, f);
+        auto b = reference.dijkstraPath(s, f);
+        int idx = graph.indexOf(f);
+        assert(a.GetDistances()[idx] == b.GetDistances()[idx]);
+        assert(a.GetPath().get_size() == b.GetPath().get_size());
+        for (size_t i = 0; i < a.GetPath().get_size(); ++i)
+            assert(a.GetPath()[i] == b.GetPath()[i]);
+    };
+
+    same(0, 5);   // промах
+    same(0, 3);   // попадание: другой финиш из того же источника
+    same(0, 0);
+    assert(graph.pathCache().misses() == 1 && graph.pathCache().hits() == 2);
+
+    same(1, 4);   // промах
+    same(2, 4);   // промах, вытесняет источник 0 (LRU, ёмкость 2)
+    same(1, 5);   // попадание
+    same(0, 5);   // промах
+    assert(graph.pathCache().misses() == 4 && graph.pathCache().hits() == 3);
+    assert(graph.pathCache().size() == 2);
+
+    // Правка графа меняет версию и сбрасывает кэш
+    auto before = graph.version();
+    graph.addEdge(0, 4, 1);
+    reference.addEdge(0, 4, 1);
+    assert(graph.version() != before);
+    same(0, 5);
+    assert(graph.pathCache().misses() == 5);
+    assert(graph.dijkstraPath(0, 5).GetDistances()[5] == 6);
+
+    before = graph.version();
+    graph.removeEdge(0, 4);
+    reference.removeEdge(0, 4);
+    assert(graph.version() != before && reference.version() != graph.version());
+    before = graph.version();
+    graph.removeEdge(7, 8);  // нет таких вершин — граф не менялся
+    assert(graph.version() == before);
+    same(0, 5);
+
+    graph.removeVertex(3);
+    reference.removeVertex(3);
+    same(0, 5);
+    assert(graph.dijkstraPath(0, 5).GetDistances()[graph.indexOf(5)] == 100);
+
+    // Копия и перенос графа не забирают деревья: они привязаны к
+    // исходному графу, копия начинает с пустым кэшем той же ёмкости
+    {
+        Graph<int> original = reference;
+        original.enablePathCache(2);
+        original.dijkstraPath(0, 5);
+        original.dijkstraPath(1, 5);
+        Graph<int> copy = original;
+        assert(copy.pathCache().size() == 0 && copy.pathCache().enabled());
+        Graph<int> moved = std::move(original);
+        original = Graph<int>();        // исходный граф больше не существует
+        copy.addEdge(0, 5, 1);
+
+        ShortestPathTree<int> fromCopy = copy.shortestPathTree(0);
+        assert(fromCopy.distanceTo(5) == 1);
+        assert(fromCopy.pathTo(5).GetPath().get_size() == 2);
+        assert(copy.dijkstraPath(0, 5).GetDistances()[copy.indexOf(5)] == 1);
+        assert(copy.pathCache().misses() == 1 && copy.pathCache().hits() == 1);
+
+        assert(moved.pathCache().size() == 0);
+        ShortestPathTree<int> fromMoved = moved.shortestPathTree(0);
+        assert(fromMoved.distanceTo(5) == 100);
+        assert(fromMoved.pathTo(5).GetPath().get_size() == 2);
+    }
+
+    // Выключение кэша
+    graph.enablePathCache(0);
+    assert(graph.pathCache().size() == 0);
+    same(0, 5);
+}
+
+void TestDynamicShortestPaths() {
+    Graph<int> graph;
+    const int n = 30;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i + 1 < n; ++i)
+        graph.addEdge(i, i + 1, 1 + i % 4);
+
+    DynamicShortestPaths<int> tree(graph, 0);
+    auto check = [&]() {
+        QueryWorkspace ws;
+        dijkstraSearch(graph, graph.indexOf(0), -1, ws);
+        for (int v = 0; v < n; ++v)
+        {
+            assert(tree.distance(v) == ws.distance(graph.indexOf(v)));
+            auto path = tree.path(v).GetPath();
+            assert((path.get_size() > 0) == ws.touched(graph.indexOf(v)));
+            if (path.get_size() > 0)
+                assert(path[0] == 0 && path[path.get_size() - 1] == v);
+        }
+    };
+    check();
+
+    // Детерминированная смесь правок: ускорения, удаления рёбер дерева,
+    // увеличения весов
+    for (int step = 0; step < 200; ++step)
+    {
+        int u = (step * 7 + 3) % n;
+        int v = (step * 13 + 5) % n;
+        if (u == v)
+            continue;
+        switch (step % 4)
+        {
+        case 0:
+            tree.addEdge(u, v, 1 + step % 9);
+            break;
+        case 1:
+            tree.removeEdge(u, v);
+            tree.removeEdge(v > 0 ? v - 1 : v, v);  // часто ребро дерева
+            break;
+        case 2:
+            tree.setEdgeWeight(u, v, 2 + step % 13);
+            break;
+        default:
+            tree.setEdgeWeight(u, u + 1 < n ? u + 1 : 0, 20);
+            break;
+        }
+        check();
+    }
+
+    // Правка в обход — полный пересчёт при следующем запросе
+    graph.addEdge(0, n - 1, 1);
+    assert(tree.distance(n - 1) == 1);
+    check();
+
+    bool thrown = false;
+    try
+    {
+        tree.addEdge(1, 2, -1);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void TestShortestPathTree() {
+    Graph<std::string> graph;
+    for (const char* name : {"A", "B", "C", "D", "E"})
+        graph.addVertex(name);
+    graph.addEdge("A", "B", 0.5);
+    graph.addEdge("B", "C", 0.25);
+    graph.addEdge("A", "C", 1.0);
+    graph.addEdge("C", "D", 1.5);
+    // E недостижима
+
+    ShortestPathTree<std::string> tree = graph.shortestPathTree("A");
+    const int a = graph.indexOf("A");
+    const int c = graph.indexOf("C");
+    const int d = graph.indexOf("D");
+    const int e = graph.indexOf("E");
+    assert(tree.source() == a);
+    assert(tree.distance(c) == 0.75);          // точное, не усечённое
+    assert(tree.distanceTo("D") == 2.25);
+    assert(!tree.reachable(e));
+
+    // Обход от вершины к источнику без выделения памяти
+    std::vector<int> backwards;
+    for (int v : tree.routeFrom(d))
+        backwards.push_back(v);
+    assert(backwards == std::vector<int>({d, c, graph.indexOf("B"), a}));
+    assert(tree.route(d) == std::vector<int>({a, graph.indexOf("B"), c, d}));
+    assert(tree.routeFrom(e).begin() == tree.routeFrom(e).end());
+
+    // pathTo — как у dijkstraPath, но расстояния точные для всех вершин
+    for (const char* target : {"A", "B", "C", "D", "E"})
+    {
+        auto fromTree = tree.pathTo(target);
+        auto direct = graph.dijkstraPath("A", target);
+        assert(fromTree.GetPath().get_size() == direct.GetPath().get_size());
+        for (size_t i = 0; i < direct.GetPath().get_size(); ++i)
+            assert(fromTree.GetPath()[i] == direct.GetPath()[i]);
+        assert(fromTree.GetDistances()[graph.indexOf(target)] == direct.GetDistances()[graph.indexOf(target)]);
+    }
+
+    // Нет источника — ничего не достижимо
+    ShortestPathTree<std::string> none = graph.shortestPathTree("X");
+    assert(none.source() == -1 && !none.reachable(a));
+
+    // Дерево из кэша совпадает с обычным
+    graph.enablePathCache(4);
+    ShortestPathTree<std::string> cached = graph.shortestPathTree("A");
+    ShortestPathTree<std::string> again = graph.shortestPathTree("A");
+    assert(graph.pathCache().hits() == 1);
+    assert(cached.distances() == tree.distances() && again.parents() == tree.parents());
+
+    // После правки графа дерево устарело
+    graph.addEdge("D", "E", 1);
+    bool thrown = false;
+    try
+    {
+        tree.pathTo("E");
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    auto stale = [](auto&& call) {
+        try
+        {
+            call();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    // Графу присвоили другой граф: версии не совпадают даже у графов
+    // с одинаковым числом правок, дерево отвергается
+    Graph<int> small;
+    small.addVertex(0);
+    small.addVertex(1);
+    ShortestPathTree<int> smallTree = small.shortestPathTree(0);
+    Graph<int> large;
+    for (int i = 0; i < 4; ++i)
+        large.addVertex(i);
+    small = large;
+    assert(stale([&]{ smallTree.pathTo(3); }));
+    assert(stale([&]{ smallTree.distanceTo(3); }));
+
+    // Копия без правок — тот же граф: дерево копии годится для оригинала
+    ShortestPathTree<int> largeTree = large.shortestPathTree(0);
+    Graph<int> twin = large;
+    assert(twin.version() == large.version());
+    assert(twin.shortestPathTree(0).pathTo(0).GetPath().get_size() == 1);
+    assert(largeTree.pathTo(0).GetPath().get_size() == 1);
+
+    // Граф уничтожен — дерево не трогает висячий указатель
+    ShortestPathTree<int> orphan;
+    {
+        Graph<int> temporary = large;
+        orphan = temporary.shortestPathTree(0);
+    }
+    assert(stale([&]{ orphan.pathTo(0); }));
+}
+
+void TestPathAccessors() {
+    Graph<std::string> graph;
+    for (const char* name : {"A", "B", "C"})
+        graph.addVertex(name);
+    graph.addEdge("A", "B", 1);
+    graph.addEdge("B", "C", 2);
+
+    Path<std::string> result = graph.dijkstraPath("A", "C");
+
+    // Ссылки и представления смотрят в те же массивы, без копий
+    const DynamicArray<std::string>& ref = result.GetPath();
+    std::span<const std::string> view = result.PathView();
+    assert(view.size() == 3 && view.data() == ref.get_data());
+    assert(view[0] == "A" && view[2] == "C");
+    std::span<const int> dist = result.DistancesView();
+    assert(dist.data() == result.GetDistances().get_data());
+    assert(dist[graph.indexOf("C")] == 3);
+
+    // У временного Path массив забирается перемещением
+    DynamicArray<std::string> moved = graph.dijkstraPath("A", "C").GetPath();
+    assert(moved.get_size() == 3 && moved[1] == "B");
+
+    // Take* оставляют Path пустым
+    const std::string* buffer = result.PathView().data();
+    DynamicArray<std::string> taken = result.TakePath();
+    assert(taken.get_data() == buffer && taken.get_size() == 3);
+    assert(result.PathView().empty());
+    DynamicArray<int> distances = result.TakeDistances();
+    assert(distances.get_size() == 3 && result.DistancesView().empty());
+}
+
+void TestTraversal() {
+    Graph<std::string> graph;
+    for (const char* name : {"a", "b", "c", "d", "e", "f"})
+        graph.addVertex(name);
+    graph.addEdge("a", "b", 1);
+    graph.addEdge("a", "c", 1);
+    graph.addEdge("b", "d", 1);
+    graph.addEdge("c", "d", 1);
+    graph.addEdge("d", "a", 1);
+    graph.addEdge("d", "e", 1);
+    // f недостижима
+
+    auto names = [&](const TraversalResult& result) {
+        std::vector<std::string> out;
+        for (int v : result.order)
+            out.push_back(graph.vertexName(v));
+        return out;
+    };
+
+    TraversalOptions full;
+    full.parents = true;
+    full.depths = true;
+
+    TraversalResult dfs = graph.depthFirstSearch("a", full);
+    assert((names(dfs) == std::vector<std::string>{"a", "b", "d", "e", "c"}));
+    assert(dfs.parent[graph.indexOf("e")] == graph.indexOf("d"));
+    assert(dfs.parent[graph.indexOf("c")] == graph.indexOf("a"));
+    assert(dfs.depth[graph.indexOf("e")] == 3);
+    assert(dfs.depth[graph.indexOf("f")] == -1 && dfs.parent[graph.indexOf("a")] == -1);
+
+    TraversalResult bfs = graph.breadthFirstSearch("a", full);
+    assert((names(bfs) == std::vector<std::string>{"a", "b", "c", "d", "e"}));
+    assert(bfs.depth[graph.indexOf("d")] == 2 && bfs.depth[graph.indexOf("e")] == 3);
+    assert(bfs.parent[graph.indexOf("d")] == graph.indexOf("b"));
+
+    // Без опций — только порядок; нет вершины — пустой результат
+    TraversalResult plain = graph.breadthFirstSearch("c");
+    assert(plain.parent.empty() && plain.depth.empty() && plain.order.size() == 5);
+    assert(graph.depthFirstSearch("x").empty());
+
+    // Печать — отдельно от обхода
+    std::ostringstream out;
+    printTraversal(out, graph, bfs, "BFS order");
+    assert(out.str() == "BFS order: a b c d e\n");
+
+    // Длинная цепочка: рекурсивный обход переполнил бы стек
+    Graph<int> chain;
+    const int n = 200000;
+    for (int i = 0; i < n; ++i)
+        chain.addVertex(i);
+    for (int i = 0; i + 1 < n; ++i)
+        chain.addEdge(i, i + 1, 1);
+    TraversalResult deep = chain.depthFirstSearch(0, full);
+    assert(static_cast<int>(deep.order.size()) == n);
+    assert(deep.order.back() == chain.indexOf(n - 1) && deep.depth[chain.indexOf(n - 1)] == n - 1);
+    assert(static_cast<int>(chain.breadthFirstSearch(0).order.size()) == n);
+}
+
+// Обёртка, считающая просмотренные рёбра: ленивый обход не должен
+// трогать граф дальше, чем у него попросили
+struct CountingGraph
+{
+    const Graph<int>& graph;
+    mutable int scanned = 0;
+
+    int vertexCount() const { return graph.vertexCount(); }
+    int outDegree(int u) const { return graph.outDegree(u); }
+    int outTarget(int u, int k) const
+    {
+        ++scanned;
+        return graph.outTarget(u, k);
+    }
+};
+
+void TestLazyTraversal() {
+    Graph<std::string> graph;
+    for (const char* name : {"a", "b", "c", "d", "e", "f"})
+        graph.addVertex(name);
+    graph.addEdge("a", "b", 1);
+    graph.addEdge("a", "c", 1);
+    graph.addEdge("b", "d", 1);
+    graph.addEdge("c", "d", 1);
+    graph.addEdge("d", "a", 1);
+    graph.addEdge("d", "e", 1);
+
+    // Полный ленивый обход совпадает с обычным
+    std::vector<int> lazy;
+    for (int v : graph.lazyDepthFirstSearch("a"))
+        lazy.push_back(v);
+    assert(lazy == graph.depthFirstSearch("a").order);
+    lazy.clear();
+    for (int v : graph.lazyBreadthFirstSearch("a"))
+        lazy.push_back(v);
+    assert(lazy == graph.breadthFirstSearch("a").order);
+    auto missing = graph.lazyBreadthFirstSearch("x");
+    assert(missing.begin() == missing.end());
+
+    // Конвейер ranges: имена первых трёх вершин BFS
+    std::vector<std::string> firstThree;
+    for (const std::string& name : graph.lazyBreadthFirstSearch("a")
+             | std::views::take(3)
+             | std::views::transform([&](int v) { return graph.vertexName(v); }))
+        firstThree.push_back(name);
+    assert((firstThree == std::vector<std::string>{"a", "b", "c"}));
+
+    // Остановка по условию
+    auto walk = graph.lazyDepthFirstSearch("a");
+    auto found = std::ranges::find_if(walk, [&](int v) { return graph.vertexName(v) == "d"; });
+    assert(found != walk.end() && *found == graph.indexOf("d"));
+
+    // Ранний выход: граф дальше не просматривается
+    Graph<int> chain;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i)
+        chain.addVertex(i);
+    for (int i = 0; i + 1 < n; ++i)
+        chain.addEdge(i, i + 1, 1);
+    CountingGraph counting{chain};
+    {
+        auto gen = lazyBreadthFirst(counting, chain.indexOf(0));
+        int taken = 0;
+        for (int v : gen)
+        {
+            (void)v;
+            if (++taken == 10)
+                break;
+        }
+        // генератор брошен на середине и разрушается здесь
+    }
+    assert(counting.scanned < 20);
+
+    counting.scanned = 0;
+    int count = 0;
+    for (int v : lazyDepthFirst(counting, chain.indexOf(0)))
+    {
+        (void)v;
+        ++count;
+    }
+    assert(count == n && counting.scanned == n - 1);
+}
+
+void TestParallelBfs() {
+    // Ядро с «хабами» + цепочка + недостижимые вершины
+    Graph<int> graph;
+    const int n = 300;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 1; i < 200; ++i)
+    {
+        graph.addEdge(i % 7, i, 1);
+        graph.addEdge(i, (i * 13) % 200, 1);
+    }
+    for (int i = 200; i < 280; ++i)
+        graph.addEdge(i - 1, i, 1);   // длинный хвост: фронт снова сужается
+    graph.addEdge(290, 0, 1);         // 280..299 недостижимы из 0
+
+    CsrGraph<int> csr = graph.freeze();
+    ThreadPool single(1);
+    ThreadPool several(3);
+
+    TraversalOptions depths;
+    depths.depths = true;
+
+    struct Mode { double alpha, beta; };
+    const Mode modes[] = {
+        {15.0, 18.0},   // по умолчанию
+        {0.0, 18.0},    // только сверху вниз
+        {1e9, 1e9},     // снизу вверх, начиная со второго уровня
+    };
+    for (const Mode& mode : modes)
+    {
+        DirectionOptimizingBfs<int> bfs(mode.alpha, mode.beta);
+        for (int s : {0, 5, 150, 290})
+        {
+            std::vector<int> expected = breadthFirstTraversal(csr, s, depths).depth;
+            BfsStats stats;
+            assert(bfs.run(csr, s, single, &stats) == expected);
+            assert(bfs.run(csr, s, several) == expected);
+            if (mode.alpha == 0.0)
+                assert(stats.bottomUpSteps == 0);
+            if (mode.alpha == 1e9 && s == 0)
+                assert(stats.bottomUpSteps > 0);
+        }
+    }
+
+    // Настройки по умолчанию: на таком графе работают оба направления
+    BfsStats stats;
+    DirectionOptimizingBfs<int>().run(csr, 0, several, &stats);
+    assert(stats.topDownSteps > 0 && stats.bottomUpSteps > 0);
+
+    // Нет такой вершины — все -1
+    std::vector<int> missing = DirectionOptimizingBfs<int>().levels(csr, 1000, several);
+    assert(std::count(missing.begin(), missing.end(), -1) == n);
+}
+
+template<int Width>
+void CheckMultiSourceBfs(const CsrGraph<int>& csr, const std::vector<int>& sources, int threads) {
+    const int n = csr.vertexCount();
+    MultiSourceBfs<int, Width> msbfs;
+    MultiSourceBfsResult result = msbfs.run(csr, sources, true, threads);
+
+    TraversalOptions depths;
+    depths.depths = true;
+    std::vector<int> reachedBy(n, 0);
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        std::vector<int> expected = sources[i] < 0 ? std::vector<int>(n, -1)
+                                                   : breadthFirstTraversal(csr, sources[i], depths).depth;
+        assert(result.levels[i] == expected);
+
+        int reachable = 0, eccentricity = 0;
+        long long sum = 0;
+        for (int v = 0; v < n; ++v)
+        {
+            if (expected[v] < 0)
+                continue;
+            ++reachedBy[v];
+            if (expected[v] > 0)
+            {
+                ++reachable;
+                sum += expected[v];
+                eccentricity = std::max(eccentricity, expected[v]);
+            }
+        }
+        assert(result.reachable[i] == reachable);
+        assert(result.distanceSum[i] == sum);
+        assert(result.eccentricity[i] == eccentricity);
+    }
+    assert(result.reachedBy == reachedBy);
+
+    // Без уровней — те же агрегаты
+    MultiSourceBfsResult light = msbfs.run(csr, sources, false, threads);
+    assert(light.levels.empty() && light.distanceSum == result.distanceSum);
+}
+
+void TestMultiSourceBfs() {
+    Graph<int> graph;
+    for (int i = 0; i < 420; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < 400; ++i)
+    {
+        graph.addEdge(i, (i * 13 + 5) % 400, 1);
+        if (i % 3 == 0)
+            graph.addEdge(i, (i * 7 + 1) % 400, 1);
+    }
+    graph.addEdge(410, 0, 1);               // 400..419 недостижимы из ядра
+    CsrGraph<int> csr = graph.freeze();
+
+    // Больше одного пакета, повторы и отсутствующая вершина
+    std::vector<int> sources;
+    for (int i = 0; i < 300; ++i)
+        sources.push_back(csr.indexOf((i * 37) % 420));
+    sources.push_back(sources[3]);
+    sources.push_back(-1);
+
+    CheckMultiSourceBfs<64>(csr, sources, 1);
+    CheckMultiSourceBfs<64>(csr, sources, 3);
+    CheckMultiSourceBfs<256>(csr, sources, 2);
+
+    // Близость на цепочке 0 -> 1 -> 2 -> 3: у 0 — 3 / (1 + 2 + 3)
+    Graph<int> chain;
+    for (int i = 0; i < 4; ++i)
+        chain.addVertex(i);
+    for (int i = 0; i + 1 < 4; ++i)
+        chain.addEdge(i, i + 1, 1);
+    CsrGraph<int> chainCsr = chain.freeze();
+    MultiSourceBfsResult all = MultiSourceBfs<int>().runAll(chainCsr);
+    assert(all.closeness(0) == 0.5);
+    assert(all.closeness(3) == 0.0);
+    assert(all.reachedBy[3] == 4 && all.reachedBy[0] == 1);
+}
+
+// Компоненты слабой связности простым BFS по рёбрам в обе стороны
+template<typename G>
+std::vector<int> ReferenceComponents(const G& graph) {
+    const int n = graph.vertexCount();
+    std::vector<int> component(n, -1);
+    int count = 0;
+    for (int s = 0; s < n; ++s)
+    {
+        if (component[s] >= 0)
+            continue;
+        std::vector<int> queue = {s};
+        component[s] = count;
+        for (std::size_t head = 0; head < queue.size(); ++head)
+        {
+            int u = queue[head];
+            auto visit = [&](int v, double) {
+                if (component[v] < 0)
+                {
+                    component[v] = count;
+                    queue.push_back(v);
+                }
+            };
+            graph.forEachOut(u, visit);
+            graph.forEachIn(u, visit);
+        }
+        ++count;
+    }
+    return component;
+}
+
+void TestComponents() {
+    // Большая компонента (цикл с хордами), мелкие компоненты, связанные
+    // только входящими рёбрами, и изолированные вершины
+    Graph<int> graph;
+    const int n = 5000;
+    for (int i = 0; i < n; ++i)
+        graph.addVertex(i);
+    for (int i = 0; i < 3000; ++i)
+    {
+        graph.addEdge(i, (i + 1) % 3000, 1);
+        graph.addEdge(i, (i * 17 + 3) % 3000, 1);
+        graph.addEdge(i, (i * 29 + 11) % 3000, 1);   // третий сосед — после выборки
+    }
+    for (int i = 3000; i + 3 < 4800; i += 4)
+    {
+        graph.addEdge(i + 1, i, 1);
+        graph.addEdge(i + 2, i, 1);
+        graph.addEdge(i + 3, i + 2, 1);
+    }
+    graph.addEdge(4800, 4801, 1);
+    graph.addEdge(4802, 4801, 1);
+    graph.addEdge(4803, 0, 1);     // вливается в большую компоненту
+    graph.addEdge(1, 4804, 1);
+
+    std::vector<int> expected = ReferenceComponents(graph);
+    const int expectedCount = *std::max_element(expected.begin(), expected.end()) + 1;
+    for (int threads : {1, 3})
+    {
+        ComponentsResult result = graph.weaklyConnectedComponents(threads);
+        assert(result.component == expected);   // нумерация — по наименьшей вершине
+        assert(result.count() == expectedCount);
+        assert(result.sizes[result.component[graph.indexOf(0)]] == 3002);
+        assert(result.sizes[result.component[graph.indexOf(4801)]] == 3);
+        assert(result.sizes[result.component[graph.indexOf(4999)]] == 1);
+
+        CsrGraph<int> csr = graph.freeze();
+        assert(afforestComponents(csr, threads).component == expected);
+    }
+
+    // Рёбра пачками, без графа в памяти
+    CsrGraph<int> csr = graph.freeze();
+    std::vector<Edge> all;
+    for (int u = 0; u < csr.vertexCount(); ++u)
+        csr.forEachOut(u, [&](int v, double w) { all.emplace_back(u, v, w); });
+    std::size_t position = 0;
+    ComponentsResult streamed = streamComponents(csr.vertexCount(), [&](std::vector<Edge>& buffer) {
+        const std::size_t end = std::min(all.size(), position + 1000);
+        buffer.assign(all.begin() + position, all.begin() + end);
+        position = end;
+        return position < all.size();
+    }, 2);
+    assert(streamed.component == expected);
+
+    // Пустой граф
+    Graph<int> empty;
+    assert(empty.weaklyConnectedComponents().count() == 0);
+}
+
+// Все тесты подряд (lab_4 --test): дольше секунды, поэтому не при
+// каждом запуске GUI
+inline void RunTests()
+{
+    TestDijkstra();
+    TestCsrGraph();
+    TestQueryWorkspace();
+    TestIndexedHeap();
+    TestBucketQueue();
+    TestBidirectionalDijkstra();
+    TestAStar();
+    TestLandmarks();
+    TestContractionHierarchy();
+    TestDeltaStepping();
+    TestDistanceMatrix();
+    TestAllPairs();
+    TestNegativeWeights();
+    TestKShortestPaths();
+    TestPathCache();
+    TestDynamicShortestPaths();
+    TestShortestPathTree();
+    TestPathAccessors();
+    TestTraversal();
+    TestLazyTraversal();
+    TestParallelBfs();
+    TestMultiSourceBfs();
+    TestComponents();
+}
+
 #endif // LAB4_TESTS
@@ -0,0 +1,203 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <vector>
+#include <utility>
+#include <ostream>
+#include "QueryWorkspace.h"
+#include "Generator.h"
+
+// Обходы DFS/BFS без рекурсии и без вывода: результат — данные.
+// DFS держит явный стек кадров (вершина, следующее ребро), поэтому
+// длинная цепочка не переполняет стек вызовов, а порядок посещения
+// совпадает с рекурсивным обходом. Посещённые — битовое множество
+// ws.seen. Граф G должен давать vertexCount, outDegree(u) и
+// outTarget(u, k) — k-й исходящий сосед (Graph<T>, CsrGraph<T>).
+
+// Что собирать помимо порядка
+struct TraversalOptions
+{
+    bool parents = false;
+    bool depths = false;
+};
+
+struct TraversalResult
+{
+    std::vector<int> order;    // индексы вершин в порядке посещения
+    std::vector<int> parent;   // по индексу вершины; -1 — старт или не посещена; пусто, если не просили
+    std::vector<int> depth;    // число рёбер в дереве обхода; -1 — не посещена; пусто, если не просили
+
+    bool empty() const { return order.empty(); }
+};
+
+namespace traversal_detail
+{
+    inline void prepare(TraversalResult& result, int vertexCount, TraversalOptions options)
+    {
+        if (options.parents)
+            result.parent.assign(vertexCount, -1);
+        if (options.depths)
+            result.depth.assign(vertexCount, -1);
+    }
+
+    inline void discover(TraversalResult& result, int v, int from)
+    {
+        result.order.push_back(v);
+        if (!result.parent.empty())
+            result.parent[v] = from;
+        if (!result.depth.empty())
+            result.depth[v] = from < 0 ? 0 : result.depth[from] + 1;
+    }
+}
+
+// start < 0 — пустой результат
+template<typename G>
+TraversalResult depthFirstTraversal(const G& graph, int start, TraversalOptions options = {},
+                                    QueryWorkspace& ws = QueryWorkspace::local())
+{
+    TraversalResult result;
+    if (start < 0)
+        return result;
+
+    const int n = graph.vertexCount();
+    traversal_detail::prepare(result, n, options);
+    ws.reset(n);
+    ws.seen.reset(n);
+    auto& stack = ws.frames;
+
+    ws.seen.set(start);
+    traversal_detail::discover(result, start, -1);
+    stack.push_back({start, 0});
+
+    while (!stack.empty())
+    {
+        auto& [v, k] = stack.back();
+        if (k == graph.outDegree(v))
+        {
+            stack.pop_back();
+            continue;
+        }
+        const int from = v;
+        const int next = graph.outTarget(v, k++);
+        if (ws.seen.insert(next))
+        {
+            traversal_detail::discover(result, next, from);
+            stack.push_back({next, 0});  // ссылки v, k дальше не используются
+        }
+    }
+    return result;
+}
+
+template<typename G>
+TraversalResult breadthFirstTraversal(const G& graph, int start, TraversalOptions options = {},
+                                      QueryWorkspace& ws = QueryWorkspace::local())
+{
+    TraversalResult result;
+    if (start < 0)
+        return result;
+
+    const int n = graph.vertexCount();
+    traversal_detail::prepare(result, n, options);
+    ws.reset(n);
+    ws.seen.reset(n);
+
+    // Очередь — сам result.order с «головой»
+    ws.seen.set(start);
+    traversal_detail::discover(result, start, -1);
+    for (std::size_t head = 0; head < result.order.size(); ++head)
+    {
+        const int cur = result.order[head];
+        const int degree = graph.outDegree(cur);
+        for (int k = 0; k < degree; ++k)
+        {
+            const int next = graph.outTarget(cur, k);
+            if (ws.seen.insert(next))
+                traversal_detail::discover(result, next, cur);
+        }
+    }
+    return result;
+}
+
+// -----------------------------------------------------------------
+//  Ленивые обходы: вершины выдаются по одной, по мере запроса.
+// for (int v : lazyBreadthFirst(graph, s)) { if (...) break; } — после
+// break граф дальше не просматривается, а стек/очередь и множество
+// посещённых живут в кадре корутины и освобождаются вместе с генератором.
+// Рабочая память потока не используется: приостановленный обход не
+// мешает другим запросам. Граф должен жить и не меняться, пока
+// генератор используется. Порядок — как у depthFirstTraversal /
+// breadthFirstTraversal.
+
+template<typename G>
+Generator<int> lazyDepthFirst(const G& graph, int start)
+{
+    if (start < 0)
+        co_return;
+
+    VisitedBitset seen;
+    seen.reset(graph.vertexCount());
+    std::vector<std::pair<int, int>> stack;
+
+    seen.set(start);
+    stack.push_back({start, 0});
+    co_yield start;
+
+    while (!stack.empty())
+    {
+        auto& [v, k] = stack.back();
+        if (k == graph.outDegree(v))
+        {
+            stack.pop_back();
+            continue;
+        }
+        const int next = graph.outTarget(v, k++);
+        if (seen.insert(next))
+        {
+            stack.push_back({next, 0});
+            co_yield next;
+        }
+    }
+}
+
+template<typename G>
+Generator<int> lazyBreadthFirst(const G& graph, int start)
+{
+    if (start < 0)
+        co_return;
+
+    VisitedBitset seen;
+    seen.reset(graph.vertexCount());
+    std::vector<int> queue;
+
+    seen.set(start);
+    queue.push_back(start);
+    co_yield start;
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const int cur = queue[head];
+        const int degree = graph.outDegree(cur);
+        for (int k = 0; k < degree; ++k)
+        {
+            const int next = graph.outTarget(cur, k);
+            if (seen.insert(next))
+            {
+                queue.push_back(next);
+                co_yield next;
+            }
+        }
+    }
+}
+
+// Печать по запросу: "<title>: a b c"
+template<typename G>
+void printTraversal(std::ostream& out, const G& graph, const TraversalResult& result,
+                    const char* title)
+{
+    out << title << ":";
+    for (int v : result.order)
+        out << " " << graph.vertexName(v);
+    out << "\n";
+}
+
+#endif // TRAVERSAL_H
@@ -2,18 +2,19 @@
 #define VERTEX_H
 
 #include <vector>
-
-// Нужно заранее объявить шаблон Edge<T> (forward-declaration),
-// чтобы Vertex<T> мог хранить вектора Edge<T>.
-template <typename T>
-struct Edge;
+#include "Edge.h"
 
 template <typename T>
 struct Vertex
 {
-    T name;                   // «Имя» вершины: может быть std::string, int, и т.д.
-    std::vector<Edge<T>> in;  // входящие рёбра
-    std::vector<Edge<T>> out; // исходящие рёбра
+    T name;                // «Имя» вершины: может быть std::string, int, и т.д.
+    std::vector<Edge> in;  // входящие рёбра
+    std::vector<Edge> out; // исходящие рёбра
+
+    // Координаты на плоскости (необязательны; нужны для A*)
+    double x = 0.0;
+    double y = 0.0;
+    bool placed = false;
 
     Vertex() = default;
 
@@ -17,9 +17,11 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QPolygonF>
+#include <QHash>
 #include <cmath>
 
 #include "tests.h"
+#include "Benchmarks.h"
 #include "Path.h"
 
 // --------------------- GraphScene Class Implementation ---------------------
@@ -63,8 +65,10 @@ protected:
                 // **Добавляем данные для текстового элемента**
                 vertexLabel->setData(0, currentVertexId); // Добавлено
 
-                // Добавляем в логический граф
-                graph->addVertex(currentVertexId++);
+                // Добавляем в логический граф (вместе с координатами для A*)
+                graph->addVertex(currentVertexId);
+                graph->setVertexPosition(currentVertexId, pos.x(), pos.y());
+                ++currentVertexId;
             }
             else if (item->type() == QGraphicsEllipseItem::Type) {
                 // (2) Добавляем ребро (дугу), если уже выбрана стартовая вершина
@@ -193,6 +197,7 @@ public:
           selectedStartVertex(-1),
           selectedEndVertex(-1)
     {
+        graph->enablePathCache(PATH_CACHE_TREES);
         auto *layout = new QVBoxLayout(this);
 
         // QGraphicsView + сцена
@@ -294,17 +299,19 @@ private slots:
             return;
         }
 
-        // Вызываем dijkstraPath
+        // Те же вершины между правками графа отвечаются из кэша деревьев
         Path<int> item = graph->dijkstraPath(selectedStartVertex, selectedEndVertex);
-        if (item.GetPath().get_size() < 2) {
+        // Представление без копирования массива
+        std::span<const int> route = item.PathView();
+        if (route.size() < 2) {
             QMessageBox::information(this, "Результат", "Кратчайший путь не найден!");
             return;
         }
 
         // Подсвечиваем рёбра (линии, стрелки), у которых (data(0) == u, data(1) == v)
-        for (size_t i = 0; i < item.GetPath().get_size() - 1; ++i) {
-            int u = item.GetPath()[i];
-            int v = item.GetPath()[i + 1];
+        for (size_t i = 0; i + 1 < route.size(); ++i) {
+            int u = route[i];
+            int v = route[i + 1];
 
             // Проходим по всем items
             for (auto *it : scene->items()) {
@@ -327,9 +334,9 @@ private slots:
 
         // Формируем строку пути
         QString pathStr = "Найден кратчайший путь: ";
-        for (int i = 0; i < item.GetPath().get_size(); ++i) {
-            pathStr += QString::number(item.GetPath()[i]);
-            if (i != item.GetPath().get_size() - 1)
+        for (size_t i = 0; i < route.size(); ++i) {
+            pathStr += QString::number(route[i]);
+            if (i + 1 != route.size())
                 pathStr += "->";
         }
 
@@ -341,6 +348,7 @@ private slots:
         scene->clear();
         // Пересоздаём граф
         graph = new Graph<int>();
+        graph->enablePathCache(PATH_CACHE_TREES);
         scene->setGraph(graph);
 
         selectedStartVertex = -1;
@@ -400,8 +408,7 @@ private slots:
         clearScene();
 
         // Располагаем вершины по окружности
-        QVector<QGraphicsEllipseItem*> vertexItems;
-        QVector<QPointF> vertexPositions;
+        QHash<int, QPointF> vertexPositions; // ID вершины -> позиция на сцене
 
         // 1) Добавляем вершины
         for (int i = 0; i < vertices.size(); ++i) {
@@ -410,6 +417,7 @@ private slots:
 
             double angle = i * (2 * M_PI / vertices.size());
             QPointF pos(300 + 200 * std::cos(angle), 300 + 200 * std::sin(angle));
+            graph->setVertexPosition(vertexId, pos.x(), pos.y());
 
             auto *ellipse = scene->addEllipse(pos.x() - 15, pos.y() - 15, 30, 30,
                                               QPen(Qt::black), QBrush(Qt::blue));
@@ -423,8 +431,7 @@ private slots:
             // **Добавляем данные для текстового элемента**
             vertexLabel->setData(0, vertexId); // Добавлено
 
-            vertexItems.append(ellipse);
-            vertexPositions.append(pos);
+            vertexPositions.insert(vertexId, pos);
         }
 
         // 2) Рёбра
@@ -444,15 +451,8 @@ private slots:
             graph->addEdge(fromVertex, toVertex, weight);
 
             // Ищем позиции
-            QPointF startPos, endPos;
-            for (int i = 0; i < vertexItems.size(); ++i) {
-                if (vertexItems[i]->data(0).toInt() == fromVertex) {
-                    startPos = vertexPositions[i];
-                }
-                if (vertexItems[i]->data(0).toInt() == toVertex) {
-                    endPos = vertexPositions[i];
-                }
-            }
+            QPointF startPos = vertexPositions.value(fromVertex);
+            QPointF endPos   = vertexPositions.value(toVertex);
 
             // Рисуем
             QLineF lineF(startPos, endPos);
@@ -493,6 +493,9 @@ private slots:
     }
 
 private:
+    // Сколько источников помнит кэш путей
+    static constexpr std::size_t PATH_CACHE_TREES = 16;
+
     Graph<int> *graph;
     GraphScene *scene;
     QGraphicsView *view;
@@ -502,6 +505,18 @@ private:
 
 // --------------------- main() ---------------------
 int main(int argc, char *argv[]) {
+    // Замеры производительности вместо GUI
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        RunBenchmarks();
+        return 0;
+    }
+
+    // Полный набор тестов вместо GUI
+    if (argc > 1 && std::string(argv[1]) == "--test") {
+        RunTests();
+        return 0;
+    }
+
     // Запускаем ваши тесты (Dijkstra и т.д.)
     TestDijkstra();
 